@@ -0,0 +1,53 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+/**
+ * Minimal benchmark harness - The Channel Strip
+ * Every .cpp in Benchmarks/ registers its cases with a static Registration;
+ * Main.cpp runs every case whose name contains the command-line filter.
+ */
+namespace Benchmark
+{
+    struct Case
+    {
+        juce::String name;
+        std::function<void()> run;
+    };
+
+    inline std::vector<Case>& registry()
+    {
+        static std::vector<Case> cases;
+        return cases;
+    }
+
+    struct Registration
+    {
+        Registration(const char* name, std::function<void()> run)
+        {
+            registry().push_back({ name, std::move(run) });
+        }
+    };
+
+    // Runs fn once to warm up, then `iterations` times. Returns mean microseconds per call.
+    template <typename Fn>
+    double measure(int iterations, Fn&& fn)
+    {
+        fn();
+
+        const auto start = juce::Time::getHighResolutionTicks();
+        for (int i = 0; i < iterations; ++i)
+            fn();
+        const auto end = juce::Time::getHighResolutionTicks();
+
+        return juce::Time::highResolutionTicksToSeconds(end - start) * 1.0e6 / iterations;
+    }
+
+    inline void report(const juce::String& label, double value, const char* unit)
+    {
+        std::printf("  %-48s %12.3f %s\n", label.toRawUTF8(), value, unit);
+    }
+}
@@ -0,0 +1,164 @@
+#include "Benchmark.h"
+#include "ProcessingChain.h"
+#include "ParameterIDs.h"
+#include "ParameterSet.h"
+#include "PluginProcessor.h"
+#include "DSP/HighPassFilter.h"
+#include "DSP/Equalizer.h"
+#include "DSP/Gate.h"
+#include "DSP/Compressor.h"
+#include "DSP/Limiter.h"
+#include "DSP/MidSide.h"
+
+namespace
+{
+    using P = ParamIDs::Index;
+
+    constexpr double kSampleRate = 48000.0;
+    constexpr int kIterations = 2000;
+
+    struct Rig
+    {
+        HighPassFilter hpf;
+        Equalizer eq;
+        Gate gate;
+        Compressor comp;
+        Limiter limiter;
+        Limiter ceilingLimiter;
+        ProcessingChain::Stages stages;
+        juce::AudioBuffer<float> noise, buffer;
+
+        explicit Rig(int blockSize)
+            : noise(2, blockSize), buffer(2, blockSize)
+        {
+            const juce::dsp::ProcessSpec spec { kSampleRate, (juce::uint32) blockSize, 2 };
+            hpf.prepare(spec);
+            eq.prepare(spec);
+            gate.prepare(spec);
+            comp.prepare(spec);
+            limiter.prepare(spec);
+            ceilingLimiter.prepare(spec);
+
+            stages.highPassFilter = &hpf;
+            stages.equalizer = &eq;
+            stages.gate = &gate;
+            stages.compressor = &comp;
+            stages.limiter = &limiter;
+            stages.ceilingLimiter = &ceilingLimiter;
+
+            juce::Random random(7);
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < blockSize; ++i)
+                    noise.setSample(ch, i, random.nextFloat() * 2.0f - 1.0f);
+        }
+    };
+
+    ParameterSet defaultParameters()
+    {
+        TheChannelStripProcessor processor;
+        ParameterSet params;
+
+        for (int i = 0; i < ParamIDs::numParameters; ++i)
+        {
+            auto* param = processor.getAPVTS().getParameter(ParamIDs::all[i]);
+            params.values[(size_t) i] = param->convertFrom0to1(param->getDefaultValue());
+        }
+
+        return params;
+    }
+
+    void setMask(ParameterSet& params, int mask)
+    {
+        params[P::hpfEnabled] = (mask & 1) != 0 ? 1.0f : 0.0f;
+        params[P::eqEnabled] = (mask & 2) != 0 ? 1.0f : 0.0f;
+        params[P::gateEnabled] = (mask & 4) != 0 ? 1.0f : 0.0f;
+        params[P::compEnabled] = (mask & 8) != 0 ? 1.0f : 0.0f;
+        params[P::limiterEnabled] = (mask & 16) != 0 ? 1.0f : 0.0f;
+    }
+
+    // Mean time per block over all 32 enable combinations (default routing)
+    template <typename Process>
+    double measureAllMasks(Rig& rig, ParameterSet params, Process&& process)
+    {
+        double total = 0.0;
+
+        for (int mask = 0; mask < ProcessingChain::kNumMasks; ++mask)
+        {
+            setMask(params, mask);
+
+            total += Benchmark::measure(kIterations, [&] {
+                for (int ch = 0; ch < 2; ++ch)
+                    rig.buffer.copyFrom(ch, 0, rig.noise, ch, 0, rig.noise.getNumSamples());
+
+                juce::dsp::AudioBlock<float> block(rig.buffer);
+                juce::dsp::ProcessContextReplacing<float> context(block);
+                ProcessingChain::State state;
+                process(params, context, state);
+            });
+        }
+
+        return total / ProcessingChain::kNumMasks;
+    }
+
+    void runChainBenchmarks()
+    {
+        const auto params = defaultParameters();
+
+        for (int blockSize : { 16, 64, 256 })
+        {
+            Rig rig(blockSize);
+
+            const double branched = measureAllMasks(rig, params, [&](const ParameterSet& p, auto& context, auto& state) {
+                ProcessingChain::processBranched(rig.stages, p, 0, context, state);
+            });
+
+            const double specialised = measureAllMasks(rig, params, [&](const ParameterSet& p, auto& context, auto& state) {
+                ProcessingChain::select(0, ProcessingChain::getEnableMask(p))(rig.stages, p, context, state);
+            });
+
+            const juce::String size = juce::String(blockSize) + "-sample blocks";
+            Benchmark::report("Runtime branches, " + size, branched, "us/block");
+            Benchmark::report("Specialised variant, " + size, specialised, "us/block");
+            Benchmark::report("Speed-up, " + size, branched / specialised, "x");
+        }
+    }
+
+    // The limiter alone in each channel mode: the mid/side modes add the
+    // decode and the L/R ceiling pass
+    void runLimiterModeBenchmarks()
+    {
+        auto params = defaultParameters();
+        setMask(params, 16);
+        params[P::limiterCeiling] = -12.0f;
+
+        Rig rig(64);
+        const auto process = ProcessingChain::select(0, ProcessingChain::getEnableMask(params));
+        double lr = 0.0;
+
+        for (int mode = 0; mode < MidSide::getModeNames().size(); ++mode)
+        {
+            params[P::limiterMode] = (float) mode;
+
+            const double time = Benchmark::measure(kIterations * 10, [&] {
+                for (int ch = 0; ch < 2; ++ch)
+                    rig.buffer.copyFrom(ch, 0, rig.noise, ch, 0, rig.noise.getNumSamples());
+
+                juce::dsp::AudioBlock<float> block(rig.buffer);
+                juce::dsp::ProcessContextReplacing<float> context(block);
+                ProcessingChain::State state;
+                state.midSide = MidSide::needsMidSide(static_cast<MidSide::Mode>(mode));
+                process(rig.stages, params, context, state);
+            });
+
+            if (mode == 0)
+                lr = time;
+
+            const auto name = MidSide::getModeNames()[mode];
+            Benchmark::report("Limiter " + name + ", 64-sample blocks", time, "us/block");
+            Benchmark::report("Limiter " + name + " / L/R", time / lr, "x");
+        }
+    }
+
+    Benchmark::Registration chainBenchmarks("Processing chain dispatch", runChainBenchmarks);
+    Benchmark::Registration limiterModeBenchmarks("Limiter channel modes", runLimiterModeBenchmarks);
+}
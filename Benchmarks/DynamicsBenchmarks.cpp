@@ -0,0 +1,82 @@
+#include "Benchmark.h"
+#include "DSP/Gate.h"
+#include "DSP/Compressor.h"
+#include "DSP/Limiter.h"
+#include <cmath>
+#include <cstdio>
+
+namespace
+{
+    constexpr double kSampleRate = 48000.0;
+    constexpr int kBlockSize = 64;
+    constexpr int kIterations = 50000;
+
+    // Stereo programme with uncorrelated channels, loud enough that every
+    // stage is working
+    juce::AudioBuffer<float> makeSource()
+    {
+        juce::AudioBuffer<float> source(2, kBlockSize);
+        for (int i = 0; i < kBlockSize; ++i)
+        {
+            source.setSample(0, i, (float) (0.7 * std::sin(i * 0.21)));
+            source.setSample(1, i, (float) (0.4 * std::sin(i * 0.13 + 1.0)));
+        }
+
+        return source;
+    }
+
+    // Mean ns per block at one link setting (the source is restored every
+    // block so the levels stay put)
+    template <typename Stage, typename Configure>
+    double measureStage(float linkPercent, Configure&& configure)
+    {
+        const auto source = makeSource();
+        juce::AudioBuffer<float> buffer(2, kBlockSize);
+
+        Stage stage;
+        stage.prepare({ kSampleRate, (juce::uint32) kBlockSize, 2 });
+        configure(stage);
+        stage.setStereoLink(linkPercent);
+
+        return Benchmark::measure(kIterations, [&] {
+            buffer.makeCopyOf(source, true);
+            juce::dsp::AudioBlock<float> block(buffer);
+            juce::dsp::ProcessContextReplacing<float> context(block);
+            stage.process(context);
+        }) * 1000.0;
+    }
+
+    // `target`: the unlinked / linked ratio the stage is held to (0: none)
+    template <typename Stage, typename Configure>
+    void reportStage(const char* name, Configure&& configure, double target = 0.0)
+    {
+        const double linked = measureStage<Stage>(100.0f, configure);
+        const double partial = measureStage<Stage>(50.0f, configure);
+        const double unlinked = measureStage<Stage>(0.0f, configure);
+
+        Benchmark::report(juce::String(name) + " linked", linked, "ns/block");
+        Benchmark::report(juce::String(name) + " 50% link", partial, "ns/block");
+        Benchmark::report(juce::String(name) + " unlinked", unlinked, "ns/block");
+        Benchmark::report(juce::String(name) + " unlinked / linked", unlinked / linked, "x");
+
+        if (target > 0.0)
+            std::printf("  %-48s %12s\n", (juce::String(name) + " target <= " + juce::String(target, 1) + "x").toRawUTF8(),
+                        unlinked / linked <= target ? "met" : "MISSED");
+    }
+
+    // Linked detection against one envelope per channel, for each dynamics
+    // stage. The compressor's unlinked path runs its dB conversions on SIMD
+    // registers so it costs no more than the linked one's scalar log and pow.
+    void runDynamicsBenchmarks()
+    {
+        reportStage<Gate>("Gate", [](Gate& gate) { gate.setThreshold(-12.0f); });
+        reportStage<Compressor>("Compressor", [](Compressor& comp) { comp.setThreshold(-20.0f); }, 1.0);
+        reportStage<Compressor>("Compressor, double detector", [](Compressor& comp) {
+            comp.setThreshold(-20.0f);
+            comp.setDoublePrecisionDetector(true);
+        }, 1.0);
+        reportStage<Limiter>("Limiter", [](Limiter& limiter) { limiter.setCeiling(-6.0f); });
+    }
+
+    Benchmark::Registration dynamicsBenchmarks("Stereo link", runDynamicsBenchmarks);
+}
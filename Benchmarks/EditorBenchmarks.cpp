@@ -0,0 +1,87 @@
+#include "Benchmark.h"
+#include "PluginProcessor.h"
+#include "ParameterTable.h"
+#include "WebParameterBindings.h"
+#include "EditorWebView.h"
+
+namespace
+{
+    constexpr int kIterations = 200;
+    constexpr int kPageTimeoutMs = 10000;
+
+    // Keeps the editor open and the message loop running until the page has
+    // taken its first update (or the timeout), then reports every phase of
+    // the open timeline - the ones a reopen skips read -1
+    void reportOpenPhases(TheChannelStripProcessor& processor, const char* label)
+    {
+        std::unique_ptr<juce::AudioProcessorEditor> editor(processor.createEditor());
+        const auto& timeline = processor.getEditorWebView().getTimeline();
+
+        const auto deadline = juce::Time::getMillisecondCounterHiRes() + kPageTimeoutMs;
+        while (!timeline.isComplete() && juce::Time::getMillisecondCounterHiRes() < deadline)
+            juce::MessageManager::getInstance()->runDispatchLoopUntil(10);
+
+        for (int i = 0; i < EditorOpenTimeline::kNumPhases; ++i)
+        {
+            const auto phase = static_cast<EditorOpenTimeline::Phase>(i);
+            Benchmark::report(juce::String(label) + " " + EditorOpenTimeline::getPhaseName(phase),
+                              timeline.getMs(phase), "ms");
+        }
+    }
+
+    // Editor open cost, split into the parts the parameter table generates
+    // (layout, relays, attachments) and the whole editor including the web
+    // view - first open against reopen, which reuses the processor's page
+    void runEditorBenchmarks()
+    {
+        TheChannelStripProcessor processor;
+        auto& apvts = processor.getAPVTS();
+
+        Benchmark::report("Parameter layout from table", Benchmark::measure(kIterations, [] {
+            auto layout = ParameterTable::createLayout();
+            juce::ignoreUnused(layout);
+        }), "us");
+
+        Benchmark::report("Create + register relays", Benchmark::measure(kIterations, [] {
+            WebParameterBindings bindings;
+            auto options = bindings.addTo(juce::WebBrowserComponent::Options());
+            juce::ignoreUnused(options);
+        }), "us");
+
+        WebParameterBindings bindings;
+        Benchmark::report("Attach + detach", Benchmark::measure(kIterations, [&] {
+            bindings.attach(apvts);
+            bindings.detach();
+        }), "us");
+
+        Benchmark::report("Relays per editor", bindings.getNumRelays(), "relays");
+
+        // The web view needs a display; headless runs stop at the bindings
+        if (juce::Desktop::getInstance().getDisplays().getPrimaryDisplay() == nullptr)
+        {
+            std::printf("  (no display - editor construction skipped)\n");
+            return;
+        }
+
+        // Page phases of a first open (browser created, page loaded and booted)
+        // and of a reopen (booted page re-parented)
+        {
+            TheChannelStripProcessor timed;
+            reportOpenPhases(timed, "First open:");
+            reportOpenPhases(timed, "Reopen:");
+        }
+
+        // First open creates the browser and starts the page load; every later
+        // open re-parents it
+        const auto firstStart = juce::Time::getMillisecondCounterHiRes();
+        std::unique_ptr<juce::AudioProcessorEditor> first(processor.createEditor());
+        Benchmark::report("Editor first open", juce::Time::getMillisecondCounterHiRes() - firstStart, "ms");
+        first.reset();
+
+        Benchmark::report("Editor reopen", Benchmark::measure(20, [&] {
+            std::unique_ptr<juce::AudioProcessorEditor> editor(processor.createEditor());
+        }) / 1000.0, "ms");
+    }
+
+    Benchmark::Registration editorBenchmarks("Editor open", runEditorBenchmarks);
+}
@@ -0,0 +1,440 @@
+#include "Benchmark.h"
+#include "PluginProcessor.h"
+#include "ParameterIDs.h"
+#include "ParameterSet.h"
+#include "StageArena.h"
+#include <cmath>
+#include <cstring>
+
+#if JUCE_LINUX
+ #include <linux/perf_event.h>
+ #include <sys/ioctl.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+ #include <cerrno>
+#endif
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+ #include <malloc.h>
+ #define THE_CHANNEL_STRIP_HEAP_STATS 1
+#else
+ #define THE_CHANNEL_STRIP_HEAP_STATS 0
+#endif
+
+/**
+ * Many instances
+ *
+ * A large session runs hundreds of strips, each touching its own DSP state
+ * once per host block, so every block starts cold. Cycling through the
+ * instances measures that case against one instance that stays in cache,
+ * for whole processors and then for the stages alone: once in the stage
+ * arena and once with every stage in its own heap allocation, made stage
+ * by stage across the instances the way a long-running host scatters them.
+ *
+ * Footprints come from the heap (glibc) so they include what the stages
+ * allocate beside the arena. Cache misses are read with perf_event_open on
+ * Linux; elsewhere, or where the kernel refuses the counters, the case says
+ * so and reports times only.
+ */
+namespace
+{
+    using P = ParamIDs::Index;
+
+    constexpr double kSampleRate = 48000.0;
+    constexpr int kBlockSize = 256;
+    constexpr int kSliceSize = 64;  // The processor's sub-block size
+    constexpr int kNumInstances = 256;
+    constexpr int kRounds = 40;
+
+    // Bytes the heap has handed out and not taken back (0 where unknown)
+    size_t heapInUse()
+    {
+       #if THE_CHANNEL_STRIP_HEAP_STATS
+        const auto info = mallinfo2();
+        return info.uordblks + info.hblkhd;
+       #else
+        return 0;
+       #endif
+    }
+
+    // Heap a default-constructed T allocates in prepare()
+    template <typename T>
+    size_t preparedHeapBytes(const juce::dsp::ProcessSpec& spec)
+    {
+        auto object = std::make_unique<T>();
+        const auto before = heapInUse();
+        object->prepare(spec);
+        const auto after = heapInUse();
+        return after > before ? after - before : 0;
+    }
+
+    // ==============================================================================
+    // Cache misses of the calling thread around a piece of work
+    // ==============================================================================
+    class CacheMissCounter
+    {
+    public:
+        struct Counts
+        {
+            double cacheMisses = 0.0;  // Last level
+            double l1Misses = 0.0;     // L1 data reads
+        };
+
+        CacheMissCounter()
+        {
+           #if JUCE_LINUX
+            lastLevel = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+            l1 = open(PERF_TYPE_HW_CACHE, (juce::uint64) PERF_COUNT_HW_CACHE_L1D
+                                              | ((juce::uint64) PERF_COUNT_HW_CACHE_OP_READ << 8)
+                                              | ((juce::uint64) PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+           #else
+            error = "perf_event_open is Linux only";
+           #endif
+        }
+
+        ~CacheMissCounter()
+        {
+           #if JUCE_LINUX
+            for (const int fd : { lastLevel, l1 })
+                if (fd >= 0)
+                    close(fd);
+           #endif
+        }
+
+        bool isAvailable() const { return lastLevel >= 0 && l1 >= 0; }
+        const juce::String& getError() const { return error; }
+
+        // Misses per call of fn, over `iterations` calls
+        template <typename Fn>
+        Counts measure(int iterations, Fn&& fn)
+        {
+            Counts counts;
+
+           #if JUCE_LINUX
+            if (!isAvailable())
+                return counts;
+
+            fn();
+
+            for (const int fd : { lastLevel, l1 })
+            {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+
+            for (int i = 0; i < iterations; ++i)
+                fn();
+
+            for (const int fd : { lastLevel, l1 })
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+            counts.cacheMisses = (double) read(lastLevel) / iterations;
+            counts.l1Misses = (double) read(l1) / iterations;
+           #else
+            juce::ignoreUnused(iterations, fn);
+           #endif
+
+            return counts;
+        }
+
+    private:
+       #if JUCE_LINUX
+        int open(juce::uint32 type, juce::uint64 config)
+        {
+            perf_event_attr attributes;
+            std::memset(&attributes, 0, sizeof(attributes));
+            attributes.size = sizeof(attributes);
+            attributes.type = type;
+            attributes.config = config;
+            attributes.disabled = 1;
+            attributes.exclude_kernel = 1;
+            attributes.exclude_hv = 1;
+
+            const int fd = (int) syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+            if (fd < 0 && error.isEmpty())
+                error = "perf_event_open failed (" + juce::String(std::strerror(errno)) + ")";
+
+            return fd;
+        }
+
+        static juce::uint64 read(int fd)
+        {
+            juce::uint64 value = 0;
+            if (::read(fd, &value, sizeof(value)) != (ssize_t) sizeof(value))
+                return 0;
+
+            return value;
+        }
+       #endif
+
+        int lastLevel = -1, l1 = -1;
+        juce::String error;
+    };
+
+    void reportTime(CacheMissCounter& counter, const juce::String& label, double nsPerBlock,
+                    const CacheMissCounter::Counts& misses)
+    {
+        Benchmark::report(label, nsPerBlock, "ns/block");
+
+        if (counter.isAvailable())
+        {
+            Benchmark::report(label + ": cache misses", misses.cacheMisses, "per block");
+            Benchmark::report(label + ": L1d read misses", misses.l1Misses, "per block");
+        }
+    }
+
+    // ==============================================================================
+    // Whole processors
+    // ==============================================================================
+    std::unique_ptr<TheChannelStripProcessor> makeInstance()
+    {
+        auto processor = std::make_unique<TheChannelStripProcessor>();
+
+        // Every stage in the signal path working
+        for (const auto* id : { ParamIDs::hpfEnabled, ParamIDs::eqEnabled, ParamIDs::gateEnabled,
+                                ParamIDs::compEnabled, ParamIDs::limiterEnabled })
+            processor->getAPVTS().getParameter(id)->setValueNotifyingHost(1.0f);
+
+        processor->setRateAndBufferSizeDetails(kSampleRate, kBlockSize);
+        processor->prepareToPlay(kSampleRate, kBlockSize);
+        return processor;
+    }
+
+    void fillSource(juce::AudioBuffer<float>& source)
+    {
+        for (int i = 0; i < source.getNumSamples(); ++i)
+        {
+            source.setSample(0, i, (float) (0.5 * std::sin(i * 0.05)));
+            source.setSample(1, i, (float) (0.5 * std::sin(i * 0.07)));
+        }
+    }
+
+    void runInstanceBenchmarks()
+    {
+        juce::AudioBuffer<float> source(2, kBlockSize), buffer(2, kBlockSize);
+        fillSource(source);
+
+        CacheMissCounter counter;
+        if (!counter.isAvailable())
+            std::printf("  No cache miss counts: %s\n", counter.getError().toRawUTF8());
+
+        const auto heapBefore = heapInUse();
+        std::vector<std::unique_ptr<TheChannelStripProcessor>> instances;
+        for (int i = 0; i < kNumInstances; ++i)
+            instances.push_back(makeInstance());
+        const auto heapAfter = heapInUse();
+        const auto heapPerInstance = heapAfter > heapBefore ? (double) (heapAfter - heapBefore) / kNumInstances : 0.0;
+
+        const juce::dsp::ProcessSpec spec { kSampleRate, (juce::uint32) kBlockSize, 2 };
+        const auto lookaheadBytes = preparedHeapBytes<LookaheadDelay>(spec);
+        const auto inputStageBytes = preparedHeapBytes<InputStage>(spec);
+        const auto equalizerBytes = preparedHeapBytes<Equalizer>(spec);
+
+        juce::MidiBuffer midi;
+        const auto processOne = [&](TheChannelStripProcessor& processor)
+        {
+            buffer.makeCopyOf(source, true);
+            processor.processBlock(buffer, midi);
+        };
+
+        const auto warm = [&] { processOne(*instances.front()); };
+        const auto roundRobin = [&] {
+            for (auto& instance : instances)
+                processOne(*instance);
+        };
+
+        const double single = Benchmark::measure(kRounds * kNumInstances, warm) * 1000.0;
+        const double cycled = Benchmark::measure(kRounds, roundRobin) * 1000.0 / kNumInstances;
+        const auto singleMisses = counter.measure(kRounds * kNumInstances, warm);
+        auto cycledMisses = counter.measure(kRounds, roundRobin);
+        cycledMisses.cacheMisses /= kNumInstances;
+        cycledMisses.l1Misses /= kNumInstances;
+
+        Benchmark::report("Stage arena per instance", (double) sizeof(StageArena), "bytes");
+        Benchmark::report("  + LookaheadDelay storage", (double) lookaheadBytes, "bytes");
+        Benchmark::report("  + InputStage oversampled drive", (double) inputStageBytes, "bytes");
+        Benchmark::report("  + Equalizer precision bands", (double) equalizerBytes, "bytes");
+        Benchmark::report("Stages in total per instance",
+                          (double) (sizeof(StageArena) + lookaheadBytes + inputStageBytes + equalizerBytes), "bytes");
+        Benchmark::report("Processor object per instance", (double) sizeof(TheChannelStripProcessor), "bytes");
+
+        if (heapPerInstance > 0.0)
+            Benchmark::report("Heap per instance (construct + prepare)", heapPerInstance, "bytes");
+
+        reportTime(counter, "One instance, warm", single, singleMisses);
+        reportTime(counter, juce::String(kNumInstances) + " instances, round robin", cycled, cycledMisses);
+        Benchmark::report("Round robin / warm", cycled / single, "x");
+
+        for (auto& instance : instances)
+            instance->releaseResources();
+    }
+
+    // ==============================================================================
+    // Stage layout: the arena against one heap allocation per stage
+    // ==============================================================================
+    struct StripStages
+    {
+        InputStage* inputStage = nullptr;
+        OutputStage* outputStage = nullptr;
+        LookaheadDelay* lookahead = nullptr;
+        ProcessingChain::Stages chain;
+    };
+
+    struct ScatteredStages
+    {
+        std::unique_ptr<InputStage> inputStage;
+        std::unique_ptr<HighPassFilter> highPassFilter;
+        std::unique_ptr<Equalizer> equalizer;
+        std::unique_ptr<Gate> gate;
+        std::unique_ptr<Compressor> compressor;
+        std::unique_ptr<Limiter> limiter;
+        std::unique_ptr<Limiter> ceilingLimiter;
+        std::unique_ptr<OutputStage> outputStage;
+        std::unique_ptr<LookaheadDelay> lookahead;
+    };
+
+    // Stage by stage across all instances, so no instance's stages are
+    // neighbours on the heap
+    template <typename Member>
+    void allocateEach(std::vector<ScatteredStages>& instances, Member member)
+    {
+        for (auto& instance : instances)
+            instance.*member = std::make_unique<typename std::remove_reference_t<decltype(instance.*member)>::element_type>();
+    }
+
+    ParameterSet allStagesParameters()
+    {
+        TheChannelStripProcessor processor;
+        ParameterSet params;
+
+        for (int i = 0; i < ParamIDs::numParameters; ++i)
+        {
+            auto* param = processor.getAPVTS().getParameter(ParamIDs::all[i]);
+            params.values[(size_t) i] = param->convertFrom0to1(param->getDefaultValue());
+        }
+
+        for (const auto index : { P::hpfEnabled, P::eqEnabled, P::gateEnabled, P::compEnabled, P::limiterEnabled })
+            params[index] = 1.0f;
+
+        return params;
+    }
+
+    // The processor's slice loop without its parameter reads and meters
+    template <typename Chain>
+    void processStrip(StripStages& strip, const ParameterSet& params, Chain&& chain, juce::AudioBuffer<float>& buffer)
+    {
+        strip.lookahead->setLookahead(LookaheadDelay::gate, params[P::gateLookahead]);
+        strip.lookahead->setLookahead(LookaheadDelay::comp, params[P::compLookahead]);
+
+        juce::dsp::AudioBlock<float> block(buffer);
+        ProcessingChain::State state;
+
+        for (size_t start = 0; start < block.getNumSamples(); start += (size_t) kSliceSize)
+        {
+            auto slice = block.getSubBlock(start, juce::jmin((size_t) kSliceSize, block.getNumSamples() - start));
+            juce::dsp::ProcessContextReplacing<float> context(slice);
+
+            strip.inputStage->process(context);
+            state.midSide = false;
+            chain(strip.chain, params, context, state);
+            strip.outputStage->setMidSideInput(state.midSide);
+            strip.outputStage->process(context);
+        }
+    }
+
+    void runLayoutBenchmarks()
+    {
+        const juce::dsp::ProcessSpec spec { kSampleRate, (juce::uint32) kBlockSize, 2 };
+        const auto params = allStagesParameters();
+        const auto chain = ProcessingChain::select(0, ProcessingChain::getEnableMask(params));
+
+        juce::AudioBuffer<float> source(2, kBlockSize), buffer(2, kBlockSize);
+        fillSource(source);
+
+        CacheMissCounter counter;
+        if (!counter.isAvailable())
+            std::printf("  No cache miss counts: %s\n", counter.getError().toRawUTF8());
+
+        std::vector<std::unique_ptr<StageArena>> arenas;
+        std::vector<StripStages> arenaStrips((size_t) kNumInstances);
+
+        for (auto& strip : arenaStrips)
+        {
+            auto& arena = *arenas.emplace_back(std::make_unique<StageArena>());
+            arena.prepare(spec);
+            arena.fillChainStages(strip.chain);
+            strip.inputStage = &arena.inputStage;
+            strip.outputStage = &arena.outputStage;
+            strip.lookahead = &arena.lookahead;
+        }
+
+        std::vector<ScatteredStages> scattered((size_t) kNumInstances);
+        allocateEach(scattered, &ScatteredStages::inputStage);
+        allocateEach(scattered, &ScatteredStages::highPassFilter);
+        allocateEach(scattered, &ScatteredStages::equalizer);
+        allocateEach(scattered, &ScatteredStages::gate);
+        allocateEach(scattered, &ScatteredStages::compressor);
+        allocateEach(scattered, &ScatteredStages::limiter);
+        allocateEach(scattered, &ScatteredStages::ceilingLimiter);
+        allocateEach(scattered, &ScatteredStages::outputStage);
+        allocateEach(scattered, &ScatteredStages::lookahead);
+
+        std::vector<StripStages> scatteredStrips((size_t) kNumInstances);
+
+        for (size_t i = 0; i < scattered.size(); ++i)
+        {
+            auto& stages = scattered[i];
+            auto& strip = scatteredStrips[i];
+
+            stages.gate->setLookahead(&stages.lookahead->getLine(LookaheadDelay::gate));
+            stages.compressor->setLookahead(&stages.lookahead->getLine(LookaheadDelay::comp));
+
+            stages.inputStage->prepare(spec);
+            stages.highPassFilter->prepare(spec);
+            stages.equalizer->prepare(spec);
+            stages.gate->prepare(spec);
+            stages.compressor->prepare(spec);
+            stages.limiter->prepare(spec);
+            stages.ceilingLimiter->prepare(spec);
+            stages.outputStage->prepare(spec);
+            stages.lookahead->prepare(spec);
+
+            strip.chain.highPassFilter = stages.highPassFilter.get();
+            strip.chain.equalizer = stages.equalizer.get();
+            strip.chain.gate = stages.gate.get();
+            strip.chain.compressor = stages.compressor.get();
+            strip.chain.limiter = stages.limiter.get();
+            strip.chain.ceilingLimiter = stages.ceilingLimiter.get();
+            strip.inputStage = stages.inputStage.get();
+            strip.outputStage = stages.outputStage.get();
+            strip.lookahead = stages.lookahead.get();
+        }
+
+        const auto roundRobin = [&](std::vector<StripStages>& strips) {
+            return [&buffer, &source, &params, &chain, &strips] {
+                for (auto& strip : strips)
+                {
+                    buffer.makeCopyOf(source, true);
+                    processStrip(strip, params, chain, buffer);
+                }
+            };
+        };
+
+        const auto measure = [&](const juce::String& label, std::vector<StripStages>& strips) {
+            const double time = Benchmark::measure(kRounds, roundRobin(strips)) * 1000.0 / kNumInstances;
+            auto misses = counter.measure(kRounds, roundRobin(strips));
+            misses.cacheMisses /= kNumInstances;
+            misses.l1Misses /= kNumInstances;
+            reportTime(counter, label, time, misses);
+            return time;
+        };
+
+        const juce::String count(kNumInstances);
+        const double arenaTime = measure(count + " stage arenas, round robin", arenaStrips);
+        const double scatteredTime = measure(count + " scattered stage sets, round robin", scatteredStrips);
+        Benchmark::report("Scattered / arena", scatteredTime / arenaTime, "x");
+    }
+
+    Benchmark::Registration instanceBenchmarks("Instances", runInstanceBenchmarks);
+    Benchmark::Registration layoutBenchmarks("Instances: stage layout", runLayoutBenchmarks);
+}
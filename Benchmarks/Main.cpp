@@ -0,0 +1,22 @@
+#include "Benchmark.h"
+#include <juce_events/juce_events.h>
+
+int main(int argc, char* argv[])
+{
+    // Processors and editors expect a message manager
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    const juce::String filter = argc > 1 ? juce::String(argv[1]) : juce::String();
+
+    for (const auto& benchmark : Benchmark::registry())
+    {
+        if (filter.isNotEmpty() && !benchmark.name.containsIgnoreCase(filter))
+            continue;
+
+        std::printf("%s\n", benchmark.name.toRawUTF8());
+        benchmark.run();
+        std::printf("\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include "Benchmark.h"
+#include "DSP/Saturation.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    constexpr double kSampleRate = 48000.0;
+    constexpr int kBlockSize = 64;
+    constexpr int kIterations = 20000;
+    constexpr float kDrive = 8.0f;           // +18 dB
+    constexpr double kToneHz = 5123.0;       // High enough for the harmonics to fold
+    constexpr int kAnalysisSamples = 48000;  // One second after a one second settle
+
+    // Reference: plain tanh waveshaping at 4x through JUCE's polyphase IIR half-band chain
+    struct OversampledShaper
+    {
+        juce::dsp::Oversampling<float> oversampling { 2, 2, juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR };
+
+        OversampledShaper() { oversampling.initProcessing((size_t) kBlockSize); }
+
+        void process(juce::dsp::AudioBlock<float>& block)
+        {
+            auto upsampled = oversampling.processSamplesUp(block);
+
+            for (size_t ch = 0; ch < upsampled.getNumChannels(); ++ch)
+            {
+                float* x = upsampled.getChannelPointer(ch);
+                for (size_t i = 0; i < upsampled.getNumSamples(); ++i)
+                    x[i] = std::tanh(x[i] * kDrive);
+            }
+
+            oversampling.processSamplesDown(block);
+        }
+    };
+
+    struct AdaaShaper
+    {
+        Saturation saturation;
+
+        AdaaShaper()
+        {
+            saturation.prepare({ kSampleRate, (juce::uint32) kBlockSize, 2 });
+            saturation.setCurve(Saturation::Curve::tape);
+        }
+
+        // The drive is InputStage's gain in the plugin
+        void process(juce::dsp::AudioBlock<float>& block)
+        {
+            block.multiplyBy(kDrive);
+            saturation.process(block);
+        }
+    };
+
+    struct NaiveShaper
+    {
+        void process(juce::dsp::AudioBlock<float>& block)
+        {
+            for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+            {
+                float* x = block.getChannelPointer(ch);
+                for (size_t i = 0; i < block.getNumSamples(); ++i)
+                    x[i] = std::tanh(x[i] * kDrive);
+            }
+        }
+    };
+
+    // Fraction of the output power that is not at DC or a harmonic of the
+    // tone - i.e. what folded back - in dB. Projecting onto sin and cos makes
+    // it independent of each shaper's latency.
+    template <typename Shaper>
+    double measureAliasingDb(Shaper& shaper)
+    {
+        juce::AudioBuffer<float> buffer(2, kBlockSize);
+        std::vector<float> output;
+        output.reserve((size_t) (2 * kAnalysisSamples));
+
+        for (int start = 0; start < 2 * kAnalysisSamples; start += kBlockSize)
+        {
+            for (int i = 0; i < kBlockSize; ++i)
+            {
+                const auto phase = juce::MathConstants<double>::twoPi * kToneHz * (start + i) / kSampleRate;
+                buffer.setSample(0, i, 0.5f * (float) std::sin(phase));
+                buffer.setSample(1, i, buffer.getSample(0, i));
+            }
+
+            juce::dsp::AudioBlock<float> block(buffer);
+            shaper.process(block);
+            output.insert(output.end(), buffer.getReadPointer(0), buffer.getReadPointer(0) + kBlockSize);
+        }
+
+        const float* y = output.data() + kAnalysisSamples;
+
+        double total = 0.0;
+        for (int n = 0; n < kAnalysisSamples; ++n)
+            total += (double) y[n] * y[n];
+        total /= kAnalysisSamples;
+
+        double harmonic = 0.0;
+        for (int k = 0; k * kToneHz < kSampleRate / 2.0; ++k)
+        {
+            double re = 0.0, im = 0.0;
+            for (int n = 0; n < kAnalysisSamples; ++n)
+            {
+                const auto phase = juce::MathConstants<double>::twoPi * k * kToneHz * n / kSampleRate;
+                re += y[n] * std::cos(phase);
+                im += y[n] * std::sin(phase);
+            }
+
+            const double power = (re * re + im * im) / ((double) kAnalysisSamples * kAnalysisSamples);
+            harmonic += k == 0 ? power : 2.0 * power;
+        }
+
+        return juce::Decibels::gainToDecibels(std::sqrt(juce::jmax(total - harmonic, 0.0) / total), -200.0);
+    }
+
+    template <typename Shaper>
+    double measureCost(Shaper& shaper)
+    {
+        juce::AudioBuffer<float> buffer(2, kBlockSize);
+        juce::Random random(7);
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < kBlockSize; ++i)
+                buffer.setSample(ch, i, random.nextFloat() - 0.5f);
+
+        return Benchmark::measure(kIterations, [&] {
+            juce::dsp::AudioBlock<float> block(buffer);
+            shaper.process(block);
+        });
+    }
+
+    template <typename Shaper>
+    void report(const char* name)
+    {
+        Shaper costShaper, aliasShaper;
+        Benchmark::report(juce::String(name) + ", cost", measureCost(costShaper), "us/block");
+        Benchmark::report(juce::String(name) + ", aliasing", measureAliasingDb(aliasShaper), "dB");
+    }
+
+    void runSaturationBenchmarks()
+    {
+        // 64-sample stereo blocks, tanh at +18 dB drive on a 5.1 kHz tone
+        report<NaiveShaper>("Naive tanh");
+        report<AdaaShaper>("ADAA soft clip (Saturation, Tape)");
+        report<OversampledShaper>("4x oversampled tanh");
+    }
+
+    Benchmark::Registration saturationBenchmarks("Input saturation", runSaturationBenchmarks);
+}
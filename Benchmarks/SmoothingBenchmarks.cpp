@@ -0,0 +1,59 @@
+#include "Benchmark.h"
+#include "DSP/GainRamp.h"
+
+namespace
+{
+    constexpr double kSampleRate = 48000.0;
+    constexpr int kBlockSize = 64;
+    constexpr int kIterations = 200000;
+
+    // Stereo gain with a target change every 20 ms block run, so about half the
+    // blocks are mid-ramp - the per-sample path pays for a ramp on all of them
+    void runSmoothingBenchmarks()
+    {
+        juce::AudioBuffer<float> buffer(2, kBlockSize);
+        for (int ch = 0; ch < 2; ++ch)
+            juce::FloatVectorOperations::fill(buffer.getWritePointer(ch), 0.5f, kBlockSize);
+
+        const auto targetFor = [](int iteration) { return (iteration / 30) % 2 == 0 ? 0.5f : 1.0f; };
+
+        juce::SmoothedValue<float> smoothed;
+        smoothed.reset(kSampleRate, 0.02);
+        int iteration = 0;
+
+        const double perSample = Benchmark::measure(kIterations, [&] {
+            smoothed.setTargetValue(targetFor(iteration++));
+            for (int i = 0; i < kBlockSize; ++i)
+            {
+                const float gain = smoothed.getNextValue();
+                for (int ch = 0; ch < 2; ++ch)
+                    buffer.getWritePointer(ch)[i] *= gain;
+            }
+        });
+
+        GainRamp<> ramp;
+        ramp.prepare(kSampleRate, 0.02, kBlockSize);
+        iteration = 0;
+
+        const double blockRamp = Benchmark::measure(kIterations, [&] {
+            ramp.setTargetValue(targetFor(iteration++));
+            if (ramp.isSmoothing())
+            {
+                const float* gain = ramp.next(kBlockSize);
+                for (int ch = 0; ch < 2; ++ch)
+                    juce::FloatVectorOperations::multiply(buffer.getWritePointer(ch), gain, kBlockSize);
+            }
+            else
+            {
+                for (int ch = 0; ch < 2; ++ch)
+                    juce::FloatVectorOperations::multiply(buffer.getWritePointer(ch), ramp.getCurrentValue(), kBlockSize);
+            }
+        });
+
+        Benchmark::report("SmoothedValue::getNextValue per sample", perSample * 1000.0, "ns/block");
+        Benchmark::report("GainRamp block ramp", blockRamp * 1000.0, "ns/block");
+        Benchmark::report("Speed-up", perSample / blockRamp, "x");
+    }
+
+    Benchmark::Registration smoothingBenchmarks("Parameter smoothing", runSmoothingBenchmarks);
+}
@@ -0,0 +1,102 @@
+#include "Benchmark.h"
+#include "PluginProcessor.h"
+#include "ParameterIDs.h"
+
+namespace
+{
+    constexpr int kNumInstances = 300;
+
+    // The 1.0 state path, kept here as the baseline
+    void saveLegacyXml(TheChannelStripProcessor& processor, juce::MemoryBlock& dest)
+    {
+        auto state = processor.getAPVTS().copyState();
+        std::unique_ptr<juce::XmlElement> xml(state.createXml());
+        xml->setAttribute("stateVersion", 1);
+        juce::AudioProcessor::copyXmlToBinary(*xml, dest);
+    }
+
+    void loadLegacyXml(TheChannelStripProcessor& processor, const juce::MemoryBlock& data)
+    {
+        std::unique_ptr<juce::XmlElement> xml(
+            juce::AudioProcessor::getXmlFromBinary(data.getData(), (int) data.getSize()));
+        processor.getAPVTS().replaceState(juce::ValueTree::fromXml(*xml));
+    }
+
+    void randomiseParameters(TheChannelStripProcessor& processor, juce::Random& random)
+    {
+        for (auto* param : processor.getParameters())
+            param->setValueNotifyingHost(random.nextFloat());
+    }
+
+    void runStateBenchmarks()
+    {
+        juce::Random random(1234);
+
+        std::vector<std::unique_ptr<TheChannelStripProcessor>> instances;
+        for (int i = 0; i < kNumInstances; ++i)
+            instances.push_back(std::make_unique<TheChannelStripProcessor>());
+
+        TheChannelStripProcessor source;
+        randomiseParameters(source, random);
+
+        juce::MemoryBlock xmlState, binaryState;
+        saveLegacyXml(source, xmlState);
+        source.getStateInformation(binaryState);
+
+        Benchmark::report("XML state size", (double) xmlState.getSize(), "bytes");
+        Benchmark::report("Binary state size", (double) binaryState.getSize(), "bytes");
+
+        Benchmark::report("Save XML", Benchmark::measure(1000, [&] {
+            juce::MemoryBlock block;
+            saveLegacyXml(source, block);
+        }), "us");
+
+        Benchmark::report("Save binary", Benchmark::measure(1000, [&] {
+            juce::MemoryBlock block;
+            source.getStateInformation(block);
+        }), "us");
+
+        // Alternate between two states so every load really changes parameters
+        TheChannelStripProcessor other;
+        randomiseParameters(other, random);
+        juce::MemoryBlock otherXml, otherBinary;
+        saveLegacyXml(other, otherXml);
+        other.getStateInformation(otherBinary);
+
+        int flip = 0;
+        Benchmark::report("Load XML, 300 instances", Benchmark::measure(20, [&] {
+            const auto& data = (flip++ & 1) ? otherXml : xmlState;
+            for (auto& instance : instances)
+                loadLegacyXml(*instance, data);
+        }) / 1000.0, "ms");
+
+        flip = 0;
+        Benchmark::report("Load binary, 300 instances", Benchmark::measure(20, [&] {
+            const auto& data = (flip++ & 1) ? otherBinary : binaryState;
+            for (auto& instance : instances)
+                instance->setStateInformation(data.getData(), (int) data.getSize());
+        }) / 1000.0, "ms");
+
+        flip = 0;
+        Benchmark::report("Load legacy XML via compat path, 300 instances", Benchmark::measure(20, [&] {
+            const auto& data = (flip++ & 1) ? otherXml : xmlState;
+            for (auto& instance : instances)
+                instance->setStateInformation(data.getData(), (int) data.getSize());
+        }) / 1000.0, "ms");
+
+        // Round trip must be lossless
+        TheChannelStripProcessor restored;
+        restored.setStateInformation(binaryState.getData(), (int) binaryState.getSize());
+        int mismatches = 0;
+        for (int i = 0; i < ParamIDs::numParameters; ++i)
+        {
+            auto* a = source.getAPVTS().getParameter(ParamIDs::all[i]);
+            auto* b = restored.getAPVTS().getParameter(ParamIDs::all[i]);
+            if (std::abs(a->getValue() - b->getValue()) > 1.0e-5f)
+                ++mismatches;
+        }
+        Benchmark::report("Round-trip mismatches", mismatches, "params");
+    }
+
+    Benchmark::Registration stateBenchmarks("State save/load", runStateBenchmarks);
+}
@@ -0,0 +1,179 @@
+#include "ConsoleEngine.h"
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+    constexpr double kDeadlineFraction = 0.8;
+    constexpr float kCostSmoothing = 0.2f;
+}
+
+ConsoleEngine::ConsoleEngine(int numStrips, int numWorkers)
+    : strips((size_t) juce::jmax(0, numStrips)),
+      order(strips.size()),
+      costs(strips.size(), 1.0f),
+      pool(numWorkers, (int) strips.size())
+{
+    for (auto& strip : strips)
+        strip.processor = std::make_unique<TheChannelStripProcessor>();
+
+    std::iota(order.begin(), order.end(), 0);
+}
+
+ConsoleEngine::~ConsoleEngine()
+{
+    release();
+}
+
+void ConsoleEngine::prepare(double sampleRate, int maximumBlockSize)
+{
+    currentSampleRate = sampleRate;
+    maxBlockSize = maximumBlockSize;
+
+    for (auto& strip : strips)
+    {
+        strip.processor->setRateAndBufferSizeDetails(sampleRate, maximumBlockSize);
+        strip.processor->prepareToPlay(sampleRate, maximumBlockSize);
+        strip.buffer.setSize(2, maximumBlockSize);
+        strip.skipped = false;
+        strip.lastOutput = {};
+    }
+
+    std::fill(costs.begin(), costs.end(), 1.0f);
+}
+
+void ConsoleEngine::release()
+{
+    for (auto& strip : strips)
+        strip.processor->releaseResources();
+}
+
+// ==============================================================================
+// Audio thread
+// ==============================================================================
+void ConsoleEngine::processBlock(const float* const* inputs, int numInputs,
+                                 float* const* outputs, int numOutputs,
+                                 int numSamples, bool enforceDeadline)
+{
+    const auto blockStart = juce::Time::getHighResolutionTicks();
+    const auto period = juce::Time::secondsToHighResolutionTicks(numSamples / currentSampleRate);
+
+    jassert(numSamples <= maxBlockSize);
+    numSamples = juce::jmin(numSamples, maxBlockSize);
+
+    blockInputs = inputs;
+    blockNumInputs = numInputs;
+    blockNumSamples = numSamples;
+
+    // Most expensive strips first - costs were settled by the previous round
+    std::sort(order.begin(), order.end(), [this](int a, int b) { return costs[(size_t) a] > costs[(size_t) b]; });
+
+    const auto deadline = enforceDeadline ? blockStart + (juce::int64) ((double) period * kDeadlineFraction) : 0;
+    pool.run(*this, order.data(), costs.data(), getNumStrips(), deadline, period);
+
+    // Sum to the bus
+    for (int ch = 0; ch < numOutputs; ++ch)
+        if (outputs[ch] != nullptr)
+            juce::FloatVectorOperations::clear(outputs[ch], numSamples);
+
+    const int busChannels = juce::jmin(2, numOutputs);
+
+    for (const auto& strip : strips)
+    {
+        for (int ch = 0; ch < busChannels; ++ch)
+            if (outputs[ch] != nullptr)
+                juce::FloatVectorOperations::add(outputs[ch], strip.buffer.getReadPointer(ch), numSamples);
+    }
+}
+
+void ConsoleEngine::loadInput(int task)
+{
+    auto& strip = strips[(size_t) task];
+    auto& buffer = strip.buffer;
+    const float* input = task < blockNumInputs ? blockInputs[task] : nullptr;
+
+    for (int ch = 0; ch < 2; ++ch)
+    {
+        if (input != nullptr)
+            buffer.copyFrom(ch, 0, input, blockNumSamples);
+        else
+            buffer.clear(ch, 0, blockNumSamples);
+    }
+}
+
+void ConsoleEngine::finishBlock(Strip& strip, bool skipped)
+{
+    // Processed and bypassed output differ by everything the strip does, so
+    // switching between them jumps; take the jump out over this block
+    const bool switched = skipped != strip.skipped;
+    strip.skipped = skipped;
+
+    for (int ch = 0; ch < 2; ++ch)
+    {
+        float* y = strip.buffer.getWritePointer(ch);
+
+        if (switched)
+        {
+            const float step = strip.lastOutput[(size_t) ch] - y[0];
+            const float scale = 1.0f / (float) (blockNumSamples + 1);
+
+            for (int i = 0; i < blockNumSamples; ++i)
+                y[i] += step * (float) (blockNumSamples - i) * scale;
+        }
+
+        strip.lastOutput[(size_t) ch] = y[blockNumSamples - 1];
+    }
+}
+
+void ConsoleEngine::process(int task)
+{
+    const auto start = juce::Time::getHighResolutionTicks();
+    auto& strip = strips[(size_t) task];
+
+    loadInput(task);
+
+    // A view of the first blockNumSamples - no allocation
+    juce::AudioBuffer<float> block(strip.buffer.getArrayOfWritePointers(), 2, blockNumSamples);
+    strip.processor->processBlock(block, strip.midi);
+    finishBlock(strip, false);
+
+    const auto elapsed = (float) (juce::Time::getHighResolutionTicks() - start);
+    auto& cost = costs[(size_t) task];
+    cost += (elapsed - cost) * kCostSmoothing;
+}
+
+void ConsoleEngine::skip(int task)
+{
+    // Bypassed for this block; keep the cost so the strip is scheduled early
+    // next time
+    auto& strip = strips[(size_t) task];
+
+    loadInput(task);
+
+    // Delayed like the processed strips, or the bus comes apart on every
+    // skip, and through the strip's own lookahead lines so they stay in time
+    juce::AudioBuffer<float> block(strip.buffer.getArrayOfWritePointers(), 2, blockNumSamples);
+    strip.processor->processBlockBypassed(block, strip.midi);
+    finishBlock(strip, true);
+}
+
+// ==============================================================================
+// juce::AudioIODeviceCallback
+// ==============================================================================
+void ConsoleEngine::audioDeviceIOCallbackWithContext(const float* const* inputChannelData, int numInputChannels,
+                                                     float* const* outputChannelData, int numOutputChannels,
+                                                     int numSamples,
+                                                     const juce::AudioIODeviceCallbackContext&)
+{
+    processBlock(inputChannelData, numInputChannels, outputChannelData, numOutputChannels, numSamples, true);
+}
+
+void ConsoleEngine::audioDeviceAboutToStart(juce::AudioIODevice* device)
+{
+    prepare(device->getCurrentSampleRate(), device->getCurrentBufferSizeSamples());
+}
+
+void ConsoleEngine::audioDeviceStopped()
+{
+    release();
+}
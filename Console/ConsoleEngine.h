@@ -0,0 +1,92 @@
+#pragma once
+
+#include <juce_audio_devices/juce_audio_devices.h>
+#include "PluginProcessor.h"
+#include "WorkStealingPool.h"
+#include <array>
+
+/**
+ * Console engine - The Channel Strip console
+ *
+ * One TheChannelStripProcessor per input channel, processed in parallel on a
+ * WorkStealingPool and summed to a stereo bus. Each mono input feeds both
+ * sides of its strip. Strips are scheduled longest-running first from a
+ * smoothed per-strip cost; a strip that has not started by the deadline
+ * (80% of the block period when driven by a device) runs its processor's
+ * bypass path for that block instead of causing a dropout. That path is a
+ * delay by the strip's latency, so the bus stays aligned, and it keeps the
+ * strip's lookahead history in time for the next processed block. The step
+ * between processed and skipped output, either way, fades out over one
+ * block.
+ */
+class ConsoleEngine : public juce::AudioIODeviceCallback,
+                      private WorkStealingPool::Job
+{
+public:
+    ConsoleEngine(int numStrips, int numWorkers);
+    ~ConsoleEngine() override;
+
+    int getNumStrips() const { return (int) strips.size(); }
+    TheChannelStripProcessor& getStrip(int index) { return *strips[(size_t) index].processor; }
+
+    void prepare(double sampleRate, int maximumBlockSize);
+    void release();
+
+    // Audio thread - one block of mono inputs (one per strip) into a stereo
+    // bus; any further output channels are cleared
+    void processBlock(const float* const* inputs, int numInputs,
+                      float* const* outputs, int numOutputs,
+                      int numSamples, bool enforceDeadline);
+
+    // ==============================================================================
+    // Load reporting (any thread)
+    // ==============================================================================
+    int getNumWorkers() const { return pool.getNumWorkers(); }
+    float getWorkerLoad(int worker) const { return pool.getLoad(worker); }
+    juce::uint64 getNumSkippedStrips() const { return pool.getNumSkipped(); }
+
+    // ==============================================================================
+    // juce::AudioIODeviceCallback
+    // ==============================================================================
+    void audioDeviceIOCallbackWithContext(const float* const* inputChannelData, int numInputChannels,
+                                          float* const* outputChannelData, int numOutputChannels,
+                                          int numSamples,
+                                          const juce::AudioIODeviceCallbackContext& context) override;
+    void audioDeviceAboutToStart(juce::AudioIODevice* device) override;
+    void audioDeviceStopped() override;
+
+private:
+    struct Strip
+    {
+        std::unique_ptr<TheChannelStripProcessor> processor;
+        juce::AudioBuffer<float> buffer;
+        juce::MidiBuffer midi;
+
+        // Whether the last block was skipped, and where each side ended
+        bool skipped = false;
+        std::array<float, 2> lastOutput {};
+    };
+
+    // WorkStealingPool::Job
+    void process(int task) override;
+    void skip(int task) override;
+
+    void loadInput(int task);
+    void finishBlock(Strip& strip, bool skipped);
+
+    std::vector<Strip> strips;
+    std::vector<int> order;
+    std::vector<float> costs; // Smoothed processing ticks per strip, written by whichever worker ran it
+
+    WorkStealingPool pool;
+
+    double currentSampleRate = 48000.0;
+    int maxBlockSize = 0;
+
+    // The block being processed
+    const float* const* blockInputs = nullptr;
+    int blockNumInputs = 0;
+    int blockNumSamples = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ConsoleEngine)
+};
@@ -0,0 +1,164 @@
+#include "ConsoleEngine.h"
+#include "ParameterIDs.h"
+#include <juce_events/juce_events.h>
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+
+/**
+ * The Channel Strip console
+ *
+ *   TheChannelStripConsole [--workers N] [--seconds S]
+ *       Opens the default audio device with every input it offers, runs one
+ *       strip per input and plays the summed bus. Prints per-worker load once
+ *       a second until Ctrl-C (or for S seconds).
+ *
+ *   TheChannelStripConsole --scaling [--strips N] [--workers N]
+ *       Offline: renders noise through 8 .. N strips (default 128) on 1 .. N
+ *       workers (default: all cores) and reports the speed-up over one worker.
+ */
+namespace
+{
+    std::atomic<bool> quitRequested { false };
+
+    int getIntOption(const juce::StringArray& args, const juce::String& name, int defaultValue)
+    {
+        const int index = args.indexOf(name);
+        return index >= 0 && index + 1 < args.size() ? args[index + 1].getIntValue() : defaultValue;
+    }
+
+    // Every stage on, so the scaling figures reflect a busy strip
+    void enableAllStages(TheChannelStripProcessor& processor)
+    {
+        for (const auto* id : { ParamIDs::hpfEnabled, ParamIDs::eqEnabled, ParamIDs::gateEnabled,
+                                ParamIDs::compEnabled, ParamIDs::limiterEnabled })
+            processor.getAPVTS().getParameter(id)->setValueNotifyingHost(1.0f);
+    }
+
+    void printLoads(const ConsoleEngine& engine)
+    {
+        juce::String line = "  load:";
+        for (int i = 0; i < engine.getNumWorkers(); ++i)
+            line << " w" << i << " " << juce::String(engine.getWorkerLoad(i) * 100.0f, 1) << "%";
+
+        line << " | skipped strips: " << juce::String((juce::int64) engine.getNumSkippedStrips());
+        std::printf("%s\n", line.toRawUTF8());
+    }
+
+    // ==============================================================================
+    // Offline scaling
+    // ==============================================================================
+    double measureBlockTime(int numStrips, int numWorkers, int blockSize, int numBlocks)
+    {
+        constexpr double sampleRate = 48000.0;
+
+        ConsoleEngine engine(numStrips, numWorkers);
+        for (int i = 0; i < numStrips; ++i)
+            enableAllStages(engine.getStrip(i));
+
+        engine.prepare(sampleRate, blockSize);
+
+        juce::AudioBuffer<float> inputs(numStrips, blockSize), outputs(2, blockSize);
+        juce::Random random(numStrips);
+        for (int ch = 0; ch < numStrips; ++ch)
+            for (int i = 0; i < blockSize; ++i)
+                inputs.setSample(ch, i, (random.nextFloat() * 2.0f - 1.0f) * 0.25f);
+
+        const auto render = [&] {
+            engine.processBlock(inputs.getArrayOfReadPointers(), numStrips,
+                                outputs.getArrayOfWritePointers(), 2, blockSize, false);
+        };
+
+        for (int i = 0; i < numBlocks / 10; ++i)
+            render();
+
+        const auto start = juce::Time::getHighResolutionTicks();
+        for (int i = 0; i < numBlocks; ++i)
+            render();
+        const auto end = juce::Time::getHighResolutionTicks();
+
+        return juce::Time::highResolutionTicksToSeconds(end - start) * 1.0e6 / numBlocks;
+    }
+
+    int runScaling(int maxStrips, int maxWorkers)
+    {
+        constexpr int blockSize = 256;
+        constexpr int numBlocks = 500;
+
+        std::printf("%-8s %-8s %14s %10s %11s\n", "strips", "workers", "us/block", "speed-up", "efficiency");
+
+        for (int strips = 8; strips <= maxStrips; strips *= 2)
+        {
+            const double single = measureBlockTime(strips, 1, blockSize, numBlocks);
+
+            for (int workers = 1; workers <= maxWorkers; workers *= 2)
+            {
+                const double time = workers == 1 ? single : measureBlockTime(strips, workers, blockSize, numBlocks);
+                const double speedUp = single / time;
+                std::printf("%-8d %-8d %14.1f %9.2fx %10.0f%%\n", strips, workers, time, speedUp, 100.0 * speedUp / workers);
+            }
+        }
+
+        return 0;
+    }
+
+    // ==============================================================================
+    // Live
+    // ==============================================================================
+    int runLive(int numWorkers, int seconds)
+    {
+        juce::AudioDeviceManager deviceManager;
+        const auto error = deviceManager.initialiseWithDefaultDevices(256, 2);
+
+        auto* device = deviceManager.getCurrentAudioDevice();
+        if (error.isNotEmpty() || device == nullptr)
+        {
+            std::fprintf(stderr, "Could not open an audio device: %s\n", error.toRawUTF8());
+            return 1;
+        }
+
+        const int numStrips = device->getActiveInputChannels().countNumberOfSetBits();
+        if (numStrips == 0)
+        {
+            std::fprintf(stderr, "%s has no active inputs\n", device->getName().toRawUTF8());
+            return 1;
+        }
+
+        std::printf("%s: %d strips at %.0f Hz, %d samples, %d workers\n",
+                    device->getName().toRawUTF8(), numStrips, device->getCurrentSampleRate(),
+                    device->getCurrentBufferSizeSamples(), numWorkers);
+
+        ConsoleEngine engine(numStrips, numWorkers);
+        deviceManager.addAudioCallback(&engine);
+
+        std::signal(SIGINT, [](int) { quitRequested = true; });
+
+        for (int elapsed = 0; !quitRequested && (seconds <= 0 || elapsed < seconds); ++elapsed)
+        {
+            juce::Thread::sleep(1000);
+            printLoads(engine);
+        }
+
+        deviceManager.removeAudioCallback(&engine);
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Processors expect a message manager
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(argv[i]);
+
+    // More workers than cores only makes spinning workers take turns
+    const int numCores = juce::jmax(1, juce::SystemStats::getNumCpus());
+    const int numWorkers = juce::jlimit(1, numCores, getIntOption(args, "--workers", numCores));
+
+    if (args.contains("--scaling"))
+        return runScaling(juce::jmax(8, getIntOption(args, "--strips", 128)), numWorkers);
+
+    return runLive(numWorkers, getIntOption(args, "--seconds", 0));
+}
@@ -0,0 +1,266 @@
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <iterator>
+#include <thread>
+
+// ==============================================================================
+// Worker thread - sleeps between rounds
+// ==============================================================================
+class WorkStealingPool::Thread : public juce::Thread
+{
+public:
+    Thread(WorkStealingPool& ownerPool, int workerIndex)
+        : juce::Thread("Console worker " + juce::String(workerIndex)),
+          pool(ownerPool),
+          index(workerIndex)
+    {
+    }
+
+    void run() override
+    {
+        juce::ScopedNoDenormals noDenormals;
+        auto seenGeneration = pool.generation.load(std::memory_order_acquire);
+
+        while (pool.waitForRound(index, seenGeneration, *this))
+            pool.work(index);
+    }
+
+private:
+    WorkStealingPool& pool;
+    const int index;
+};
+
+// ==============================================================================
+WorkStealingPool::WorkStealingPool(int numWorkers, int maxTasksPerRound)
+    : expectedLoad((size_t) clampWorkers(numWorkers)),
+      queueSizes((size_t) clampWorkers(numWorkers)),
+      maxTasks(juce::jmax(0, maxTasksPerRound)),
+      spinTicks(juce::Time::secondsToHighResolutionTicks(1.0e-4))
+{
+    for (int i = 0; i < clampWorkers(numWorkers); ++i)
+    {
+        auto worker = std::make_unique<Worker>();
+        worker->queue.tasks.resize((size_t) maxTasks);
+        workers.push_back(std::move(worker));
+    }
+
+    for (size_t i = 1; i < workers.size(); ++i)
+    {
+        auto& thread = workers[i]->thread;
+        thread = std::make_unique<Thread>(*this, (int) i);
+
+        // Worker i on core i; core 0 is left to the audio device thread,
+        // which is worker 0. JUCE's affinity mask is 32 bits wide, so
+        // workers on core 32 and above are left to the scheduler.
+        if (i < 32)
+            thread->setAffinityMask((juce::uint32) 1 << i);
+
+        if (!thread->startRealtimeThread(juce::Thread::RealtimeOptions {}.withPriority(9)))
+            thread->startThread(juce::Thread::Priority::highest);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    for (auto& worker : workers)
+    {
+        if (worker->thread == nullptr)
+            continue;
+
+        worker->thread->signalThreadShouldExit();
+        worker->wake.signal();
+    }
+
+    for (auto& worker : workers)
+        if (worker->thread != nullptr)
+            worker->thread->stopThread(1000);
+}
+
+// ==============================================================================
+// Audio thread
+// ==============================================================================
+void WorkStealingPool::run(Job& jobToRun, const int* order, const float* cost, int numTasks,
+                           juce::int64 deadlineTicks, juce::int64 periodTicks)
+{
+    jassert(numTasks <= maxTasks);
+    numTasks = juce::jlimit(0, maxTasks, numTasks);
+
+    // Longest expected task first, onto the queue with the least expected work
+    std::fill(expectedLoad.begin(), expectedLoad.end(), 0.0f);
+    std::fill(queueSizes.begin(), queueSizes.end(), 0u);
+
+    for (int i = 0; i < numTasks; ++i)
+    {
+        const int task = order[i];
+        const auto target = (size_t) std::distance(expectedLoad.begin(),
+                                                   std::min_element(expectedLoad.begin(), expectedLoad.end()));
+
+        workers[target]->queue.tasks[queueSizes[target]++] = task;
+        expectedLoad[target] += juce::jmax(cost[task], 1.0e-6f);
+    }
+
+    job = &jobToRun;
+    deadline = deadlineTicks;
+    period = juce::jmax((juce::int64) 1, periodTicks);
+    remaining.store(numTasks, std::memory_order_relaxed);
+
+    for (size_t i = 0; i < workers.size(); ++i)
+        workers[i]->queue.range.store(pack(0, queueSizes[i]), std::memory_order_release);
+
+    generation.fetch_add(1, std::memory_order_seq_cst);
+
+    for (size_t i = 1; i < workers.size(); ++i)
+        if (workers[i]->sleeping.load(std::memory_order_seq_cst))
+            workers[i]->wake.signal();
+
+    work(0);
+
+    // Tasks still running on other workers
+    for (int spins = 0; remaining.load(std::memory_order_acquire) > 0; ++spins)
+        if (spins > 64)
+            std::this_thread::yield();
+}
+
+float WorkStealingPool::getLoad(int worker) const
+{
+    if (!juce::isPositiveAndBelow(worker, (int) workers.size()))
+        return 0.0f;
+
+    return workers[(size_t) worker]->load.load(std::memory_order_relaxed);
+}
+
+// ==============================================================================
+// Queues
+// ==============================================================================
+bool WorkStealingPool::popFront(Queue& queue, int& task)
+{
+    auto range = queue.range.load(std::memory_order_acquire);
+
+    for (;;)
+    {
+        const auto front = (juce::uint32) (range >> 32);
+        const auto back = (juce::uint32) range;
+
+        if (front >= back)
+            return false;
+
+        if (queue.range.compare_exchange_weak(range, pack(front + 1, back),
+                                              std::memory_order_acquire, std::memory_order_acquire))
+        {
+            task = queue.tasks[front];
+            return true;
+        }
+    }
+}
+
+bool WorkStealingPool::popBack(Queue& queue, int& task)
+{
+    auto range = queue.range.load(std::memory_order_acquire);
+
+    for (;;)
+    {
+        const auto front = (juce::uint32) (range >> 32);
+        const auto back = (juce::uint32) range;
+
+        if (front >= back)
+            return false;
+
+        if (queue.range.compare_exchange_weak(range, pack(front, back - 1),
+                                              std::memory_order_acquire, std::memory_order_acquire))
+        {
+            task = queue.tasks[back - 1];
+            return true;
+        }
+    }
+}
+
+// ==============================================================================
+// Workers
+// ==============================================================================
+void WorkStealingPool::work(int index)
+{
+    const int numWorkers = (int) workers.size();
+    auto& own = workers[(size_t) index]->queue;
+
+    juce::int64 busy = 0, roundPeriod = 1;
+    int task = 0;
+
+    for (;;)
+    {
+        if (popFront(own, task))
+        {
+            busy += runTask(task, roundPeriod);
+            continue;
+        }
+
+        // Own queue empty - steal the cheapest remaining task of a neighbour
+        bool stole = false;
+        for (int i = 1; i < numWorkers && !stole; ++i)
+        {
+            if (popBack(workers[(size_t) ((index + i) % numWorkers)]->queue, task))
+            {
+                busy += runTask(task, roundPeriod);
+                stole = true;
+            }
+        }
+
+        if (!stole)
+            break;
+    }
+
+    auto& load = workers[(size_t) index]->load;
+    const float fraction = (float) ((double) busy / (double) roundPeriod);
+    load.store(load.load(std::memory_order_relaxed) * 0.9f + fraction * 0.1f, std::memory_order_relaxed);
+}
+
+// Round state (job, deadline, period) is only read between taking a task and
+// finishing it, so run() cannot overwrite it underneath
+juce::int64 WorkStealingPool::runTask(int task, juce::int64& roundPeriod)
+{
+    const auto start = juce::Time::getHighResolutionTicks();
+    roundPeriod = period;
+
+    if (deadline != 0 && start > deadline)
+    {
+        job->skip(task);
+        skipped.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        job->process(task);
+    }
+
+    const auto elapsed = juce::Time::getHighResolutionTicks() - start;
+    remaining.fetch_sub(1, std::memory_order_acq_rel);
+    return elapsed;
+}
+
+bool WorkStealingPool::waitForRound(int index, juce::uint32& seenGeneration, const Thread& thread)
+{
+    auto& worker = *workers[(size_t) index];
+    const auto spinUntil = juce::Time::getHighResolutionTicks() + spinTicks;
+
+    for (;;)
+    {
+        if (thread.threadShouldExit())
+            return false;
+
+        const auto current = generation.load(std::memory_order_acquire);
+        if (current != seenGeneration)
+        {
+            seenGeneration = current;
+            return true;
+        }
+
+        // Spin through short gaps between blocks, sleep through long ones
+        if (juce::Time::getHighResolutionTicks() < spinUntil)
+            continue;
+
+        worker.sleeping.store(true, std::memory_order_seq_cst);
+
+        if (generation.load(std::memory_order_seq_cst) == seenGeneration && !thread.threadShouldExit())
+            worker.wake.wait(100);
+
+        worker.sleeping.store(false, std::memory_order_relaxed);
+    }
+}
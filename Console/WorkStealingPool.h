@@ -0,0 +1,97 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * Work-stealing pool - The Channel Strip console
+ *
+ * Runs one round of independent tasks per audio block. The calling (audio)
+ * thread is worker 0; the other workers are pinned to their own cores and
+ * spin briefly between rounds before sleeping. There is never more than one
+ * worker per core: spinning workers sharing a core only take turns. Pinning
+ * covers the first 32 cores, the width of JUCE's affinity mask. run() deals the tasks out
+ * most expensive first to the queue with the least expected work, so every
+ * queue starts balanced; a worker that runs dry steals from the back of the
+ * others. A task that has not started by the round's deadline is skipped
+ * instead of being allowed to overrun the block.
+ */
+class WorkStealingPool
+{
+public:
+    struct Job
+    {
+        virtual ~Job() = default;
+        virtual void process(int task) = 0;
+        virtual void skip(int task) = 0; // The deadline passed before the task started
+    };
+
+    // Starts numWorkers - 1 threads (numWorkers is clamped to the core
+    // count); maxTasks bounds every later run()
+    WorkStealingPool(int numWorkers, int maxTasks);
+    ~WorkStealingPool();
+
+    int getNumWorkers() const { return (int) workers.size(); }
+
+    // Audio thread - returns when every task has been processed or skipped.
+    // `order` lists task indices most expensive first and `cost` holds the
+    // expected duration of each task (any unit). deadline is in high-resolution
+    // ticks (0 for none); periodTicks is the block period the loads refer to.
+    void run(Job& job, const int* order, const float* cost, int numTasks,
+             juce::int64 deadline, juce::int64 periodTicks);
+
+    // Any thread - smoothed fraction of the block period a worker spent on tasks
+    float getLoad(int worker) const;
+
+    // Any thread - tasks skipped at their deadline since construction
+    juce::uint64 getNumSkipped() const { return skipped.load(std::memory_order_relaxed); }
+
+private:
+    class Thread;
+
+    // Front in the high word, back in the low word: the owner pops the front,
+    // thieves pop the back, both with one CAS on the same word
+    struct Queue
+    {
+        std::vector<int> tasks;
+        std::atomic<juce::uint64> range { 0 };
+    };
+
+    struct alignas(64) Worker
+    {
+        Queue queue;
+        std::atomic<float> load { 0.0f };
+        std::atomic<bool> sleeping { false };
+        juce::WaitableEvent wake;
+        std::unique_ptr<Thread> thread;
+    };
+
+    static int clampWorkers(int requested) { return juce::jlimit(1, juce::jmax(1, juce::SystemStats::getNumCpus()), requested); }
+    static juce::uint64 pack(juce::uint32 front, juce::uint32 back) { return ((juce::uint64) front << 32) | back; }
+
+    static bool popFront(Queue& queue, int& task);
+    static bool popBack(Queue& queue, int& task);
+    void work(int index);
+    juce::int64 runTask(int task, juce::int64& roundPeriod);
+    bool waitForRound(int index, juce::uint32& seenGeneration, const Thread& thread);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<float> expectedLoad;
+    std::vector<juce::uint32> queueSizes;
+    const int maxTasks;
+    const juce::int64 spinTicks;
+
+    // Written by run() before the queues are published, read only by a
+    // worker holding a task of the round
+    Job* job = nullptr;
+    juce::int64 deadline = 0;
+    juce::int64 period = 1;
+
+    std::atomic<juce::uint32> generation { 0 };
+    std::atomic<int> remaining { 0 };
+    std::atomic<juce::uint64> skipped { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WorkStealingPool)
+};
@@ -0,0 +1,2 @@
+#include "Biquad.h"
+// Implementation in header (inline class)
@@ -0,0 +1,73 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+
+/**
+ * Transposed direct form II biquad with its coefficients and per-channel
+ * state stored inline.
+ *
+ * The same arithmetic as juce::dsp::IIR::Filter<float> at order 2 (and the
+ * same a0 normalisation as IIR::Coefficients), but without the ref-counted
+ * coefficient object and the per-channel HeapBlock a ProcessorDuplicator
+ * spreads over the heap: a band or a cascade of sections is one contiguous
+ * run of floats inside the stage that owns it.
+ */
+class Biquad
+{
+public:
+    static constexpr size_t kMaxChannels = 2;
+
+    // b0, b1, b2, a0, a1, a2 as the ArrayCoefficients designs return them
+    void setCoefficients(const std::array<float, 6>& c)
+    {
+        const float a0 = c[3];
+        const float a0Inv = !juce::approximatelyEqual(a0, 0.0f) ? 1.0f / a0 : 0.0f;
+
+        b0 = c[0] * a0Inv;
+        b1 = c[1] * a0Inv;
+        b2 = c[2] * a0Inv;
+        a1 = c[4] * a0Inv;
+        a2 = c[5] * a0Inv;
+    }
+
+    void reset() { state.fill({}); }
+
+    void process(const juce::dsp::AudioBlock<float>& block)
+    {
+        jassert(block.getNumChannels() <= kMaxChannels);
+        const auto numChannels = juce::jmin(block.getNumChannels(), kMaxChannels);
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            process(block.getChannelPointer(ch), block.getNumSamples(), state[ch]);
+    }
+
+private:
+    struct State
+    {
+        float lv1 = 0.0f, lv2 = 0.0f;
+    };
+
+    void process(float* x, size_t numSamples, State& s) const
+    {
+        auto lv1 = s.lv1, lv2 = s.lv2;
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            const float input = x[i];
+            const float output = input * b0 + lv1;
+            x[i] = output;
+
+            lv1 = (input * b1) - (output * a1) + lv2;
+            lv2 = (input * b2) - (output * a2);
+        }
+
+        juce::dsp::util::snapToZero(lv1);
+        juce::dsp::util::snapToZero(lv2);
+
+        s.lv1 = lv1;
+        s.lv2 = lv2;
+    }
+
+    float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+    std::array<State, kMaxChannels> state {};
+};
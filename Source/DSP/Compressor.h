@@ -1,5 +1,8 @@
 #pragma once
 #include <juce_dsp/juce_dsp.h>
+#include "GainRamp.h"
+#include "LookaheadDelay.h"
+#include "StereoLink.h"
 
 class Compressor
 {
@@ -9,16 +12,17 @@ public:
     void prepare(const juce::dsp::ProcessSpec& spec)
     {
         sampleRate = spec.sampleRate;
-        envelope = 0.0f;
-        gainReduction = 0.0f;
-        smoothedMakeup.reset(spec.sampleRate, 0.02);
+        maxBlockSize = (size_t) spec.maximumBlockSize;
+        envelopes.fill(0.0);
+        channelGainReduction.fill(0.0f);
+        smoothedMakeup.prepare(spec.sampleRate, 0.02, (int) spec.maximumBlockSize);
         smoothedMakeup.setCurrentAndTargetValue(1.0f);
     }
 
     void reset()
     {
-        envelope = 0.0f;
-        gainReduction = 0.0f;
+        envelopes.fill(0.0);
+        channelGainReduction.fill(0.0f);
         smoothedMakeup.setCurrentAndTargetValue(smoothedMakeup.getTargetValue());
     }
 
@@ -29,16 +33,84 @@ public:
     void setMakeup(float dB) { smoothedMakeup.setTargetValue(juce::Decibels::decibelsToGain(dB)); }
     void setKnee(float dB) { kneeDb = dB; }
 
-    float getGainReduction() const { return gainReduction; }
+    // 100%: both channels follow the louder one; less runs one envelope per channel
+    void setStereoLink(float percent) { link = juce::jlimit(0.0f, 1.0f, percent * 0.01f); }
+
+    // Envelope arithmetic in double (offline quality profile): at high sample
+    // rates long time constants put the coefficients within a few float ulps
+    // of 1, which skews the effective attack and release
+    void setDoublePrecisionDetector(bool enabled) { doublePrecisionDetector = enabled; }
+
+    // Delay line the gain is applied through (nullptr: no lookahead)
+    void setLookahead(LookaheadDelay::Line* line) { lookahead = line; }
+    LookaheadDelay::Line* getLookahead() const { return lookahead; }
+
+    // Deepest gain reduction over the last block (dB), of either channel
+    float getGainReduction() const { return juce::jmin(channelGainReduction[0], channelGainReduction[1]); }
+
+    // Per channel of the last block (a mono block reports its channel on both)
+    float getGainReduction(size_t channel) const { return channelGainReduction[channel]; }
+
+    // Louder detector envelope at the end of the last block (dB)
+    float getDetectorLevel() const { return (float) juce::jmax(envelopes[0], envelopes[1]); }
+
+    // Static curve: gain in dB for a detector level, with the soft knee centred on the threshold
+    static float computeStaticGain(float inputDb, float thresholdDb, float ratio, float kneeDb)
+    {
+        // Soft knee compression
+        float halfKnee = kneeDb / 2.0f;
+
+        if (inputDb < thresholdDb - halfKnee || (kneeDb <= 0.0f && inputDb <= thresholdDb))
+        {
+            // Below knee - no compression (a hard knee has nothing to interpolate)
+            return 0.0f;
+        }
+        else if (inputDb > thresholdDb + halfKnee)
+        {
+            // Above knee - full compression
+            return (thresholdDb + (inputDb - thresholdDb) / ratio) - inputDb;
+        }
+        else
+        {
+            // In knee - interpolate
+            float x = inputDb - thresholdDb + halfKnee;
+            float compressionRatio = 1.0f + (1.0f / ratio - 1.0f) * (x / kneeDb);
+            return (thresholdDb - halfKnee + x * compressionRatio) - inputDb;
+        }
+    }
 
     void process(juce::dsp::ProcessContextReplacing<float>& context)
+    {
+        // Only a stereo pair has channels to unlink
+        const bool linked = link >= 1.0f || context.getOutputBlock().getNumChannels() != StereoLink::kMaxChannels;
+
+        if (linked && doublePrecisionDetector)
+            processLinked<double>(context);
+        else if (linked)
+            processLinked<float>(context);
+        else if (doublePrecisionDetector)
+            processPerChannel<double>(context);
+        else
+            processPerChannel<float>(context);
+    }
+
+private:
+    template <typename Detector>
+    void processLinked(juce::dsp::ProcessContextReplacing<float>& context)
     {
         auto& block = context.getOutputBlock();
         const auto numChannels = block.getNumChannels();
         const auto numSamples = block.getNumSamples();
 
-        float attackCoef = std::exp(-1.0f / (static_cast<float>(sampleRate) * attackMs * 0.001f));
-        float releaseCoef = std::exp(-1.0f / (static_cast<float>(sampleRate) * releaseMs * 0.001f));
+        const Detector one = 1;
+        Detector attackCoef = std::exp(-one / (static_cast<Detector>(sampleRate) * (Detector) attackMs * (Detector) 0.001));
+        Detector releaseCoef = std::exp(-one / (static_cast<Detector>(sampleRate) * (Detector) releaseMs * (Detector) 0.001));
+        Detector detector = (Detector) juce::jmax(envelopes[0], envelopes[1]);
+
+        // Makeup ramp while it moves, one scalar once it has settled
+        jassert(numSamples <= maxBlockSize);
+        const float* makeupRamp = smoothedMakeup.isSmoothing() ? smoothedMakeup.next((int) numSamples) : nullptr;
+        const float makeup = smoothedMakeup.getCurrentValue();
 
         float maxGR = 0.0f;
 
@@ -52,55 +124,165 @@ public:
             }
 
             // Convert to dB
-            float inputDb = juce::Decibels::gainToDecibels(inputLevel + 0.0001f);
+            Detector inputDb = juce::Decibels::gainToDecibels((Detector) inputLevel + (Detector) 0.0001);
 
             // Envelope follower (in dB domain)
-            if (inputDb > envelope)
-                envelope = attackCoef * envelope + (1.0f - attackCoef) * inputDb;
+            if (inputDb > detector)
+                detector = attackCoef * detector + (one - attackCoef) * inputDb;
             else
-                envelope = releaseCoef * envelope + (1.0f - releaseCoef) * inputDb;
+                detector = releaseCoef * detector + (one - releaseCoef) * inputDb;
 
             // Calculate gain reduction with soft knee
-            float gainDb = computeGain(envelope);
+            float gainDb = computeGain((float) detector);
 
             // Apply gain and makeup
-            float totalGain = juce::Decibels::decibelsToGain(gainDb) * smoothedMakeup.getNextValue();
+            float totalGain = gainFromDb(gainDb) * (makeupRamp != nullptr ? makeupRamp[sample] : makeup);
 
             for (size_t ch = 0; ch < numChannels; ++ch)
             {
-                block.getChannelPointer(ch)[sample] *= totalGain;
+                float* channel = block.getChannelPointer(ch);
+                const float input = lookahead != nullptr ? lookahead->exchange(ch, channel[sample]) : channel[sample];
+                channel[sample] = input * totalGain;
             }
 
             // Track max gain reduction
             if (-gainDb > maxGR) maxGR = -gainDb;
         }
 
-        gainReduction = -maxGR;
+        envelopes.fill(detector);
+        channelGainReduction.fill(-maxGR);
     }
 
-private:
-    float computeGain(float inputDb)
+    // One envelope per channel. The dB conversions are Lanes' approximations
+    // (within StereoLink::kDecibelTolerance) and the static curve is
+    // computeStaticGain with its branches as selects; all three run in float
+    // on whole registers of one channel's samples, a chunk at a time, around
+    // the envelopes. Those stay in the detector precision, which is what the
+    // double profile is for. Below the knee the gain is still exactly 1.
+    template <typename Detector>
+    void processPerChannel(juce::dsp::ProcessContextReplacing<float>& context)
     {
-        // Soft knee compression
-        float halfKnee = kneeDb / 2.0f;
+        using Lanes = StereoLink::Lanes<float>;
+        constexpr size_t kChunk = 64;
+        static_assert(kChunk % Lanes::width == 0, "chunks are whole registers");
+
+        auto& block = context.getOutputBlock();
+        const auto numSamples = block.getNumSamples();
+        jassert(block.getNumChannels() == StereoLink::kMaxChannels);
+
+        const Detector one = 1;
+        const Detector attackCoef = std::exp(-one / (static_cast<Detector>(sampleRate) * (Detector) attackMs * (Detector) 0.001));
+        const Detector releaseCoef = std::exp(-one / (static_cast<Detector>(sampleRate) * (Detector) releaseMs * (Detector) 0.001));
+        const StaticCurve<Lanes> curve(thresholdDb, ratio, kneeDb);
 
-        if (inputDb < thresholdDb - halfKnee)
+        jassert(numSamples <= maxBlockSize);
+        const float* makeupRamp = smoothedMakeup.isSmoothing() ? smoothedMakeup.next((int) numSamples) : nullptr;
+        const float makeup = smoothedMakeup.getCurrentValue();
+
+        std::array<float, StereoLink::kMaxChannels> deepest {};
+
+        // Levels, then dB, then envelopes, then gains, in place
+        alignas(Lanes::kAlignment) float values[StereoLink::kMaxChannels][kChunk];
+
+        for (size_t start = 0; start < numSamples; start += kChunk)
         {
-            // Below knee - no compression
-            return 0.0f;
+            const auto length = juce::jmin(kChunk, numSamples - start);
+            const auto padded = (length + Lanes::width - 1) / Lanes::width * Lanes::width;
+            const float* left = block.getChannelPointer(0) + start;
+            const float* right = block.getChannelPointer(1) + start;
+
+            for (size_t i = 0; i < length; ++i)
+            {
+                const float loudest = juce::jmax(std::abs(left[i]), std::abs(right[i]));
+                values[0][i] = StereoLink::blend(std::abs(left[i]), loudest, link) + 0.0001f;
+                values[1][i] = StereoLink::blend(std::abs(right[i]), loudest, link) + 0.0001f;
+            }
+
+            for (size_t ch = 0; ch < StereoLink::kMaxChannels; ++ch)
+            {
+                float* channel = values[ch];
+                std::fill(channel + length, channel + padded, 1.0f);
+
+                for (size_t i = 0; i < padded; i += Lanes::width)
+                    Lanes::load(channel + i).gainToDecibels().store(channel + i);
+
+                auto envelope = (Detector) envelopes[ch];
+                for (size_t i = 0; i < length; ++i)
+                {
+                    const auto inputDb = (Detector) channel[i];
+                    const Detector coef = inputDb > envelope ? attackCoef : releaseCoef;
+                    envelope = coef * envelope + (one - coef) * inputDb;
+                    channel[i] = (float) envelope;
+                }
+                envelopes[ch] = envelope;
+
+                // The padding sits below any knee, at 0 dB
+                std::fill(channel + length, channel + padded, Lanes::kMinDecibels);
+
+                auto lowest = Lanes::expand(0.0f);
+                for (size_t i = 0; i < padded; i += Lanes::width)
+                {
+                    const auto gainDb = curve(Lanes::load(channel + i));
+                    lowest = Lanes::min(lowest, gainDb);
+                    gainDb.decibelsToGain().store(channel + i);
+                }
+
+                for (size_t lane = 0; lane < Lanes::width; ++lane)
+                    deepest[ch] = juce::jmin(deepest[ch], lowest.get(lane));
+            }
+
+            for (size_t ch = 0; ch < StereoLink::kMaxChannels; ++ch)
+            {
+                float* channel = block.getChannelPointer(ch) + start;
+                const float* gains = values[ch];
+
+                for (size_t i = 0; i < length; ++i)
+                {
+                    const float input = lookahead != nullptr ? lookahead->exchange(ch, channel[i]) : channel[i];
+                    channel[i] = input * gains[i] * (makeupRamp != nullptr ? makeupRamp[start + i] : makeup);
+                }
+            }
         }
-        else if (inputDb > thresholdDb + halfKnee)
+
+        for (size_t ch = 0; ch < StereoLink::kMaxChannels; ++ch)
+            channelGainReduction[ch] = deepest[ch];
+    }
+
+    // computeStaticGain on Lanes. Above the knee the gain is
+    // (in - threshold)(1/ratio - 1); inside it, measured from the knee's
+    // start, x^2 (1/ratio - 1) / knee; below it 0.
+    template <typename Lanes>
+    struct StaticCurve
+    {
+        StaticCurve(float thresholdDb, float ratio, float kneeDb)
+            : threshold(Lanes::expand(thresholdDb)),
+              kneeStart(Lanes::expand(thresholdDb - juce::jmax(0.0f, kneeDb) / 2.0f)),
+              kneeEnd(Lanes::expand(thresholdDb + juce::jmax(0.0f, kneeDb) / 2.0f)),
+              slope(Lanes::expand(1.0f / ratio - 1.0f)),
+              kneeSlope(Lanes::expand(kneeDb > 0.0f ? (1.0f / ratio - 1.0f) / kneeDb : 0.0f))
         {
-            // Above knee - full compression
-            return (thresholdDb + (inputDb - thresholdDb) / ratio) - inputDb;
         }
-        else
+
+        Lanes operator()(const Lanes& inputDb) const
         {
-            // In knee - interpolate
-            float x = inputDb - thresholdDb + halfKnee;
-            float compressionRatio = 1.0f + (1.0f / ratio - 1.0f) * (x / kneeDb);
-            return (thresholdDb - halfKnee + x * compressionRatio) - inputDb;
+            const auto x = inputDb - kneeStart;
+            const auto inKnee = Lanes::selectGreater(kneeStart, inputDb, Lanes::expand(0), kneeSlope * x * x);
+            return Lanes::selectGreater(inputDb, kneeEnd, slope * (inputDb - threshold), inKnee);
         }
+
+        Lanes threshold, kneeStart, kneeEnd, slope, kneeSlope;
+    };
+
+    float computeGain(float inputDb) const
+    {
+        return computeStaticGain(inputDb, thresholdDb, ratio, kneeDb);
+    }
+
+    // decibelsToGain(0) is exactly 1, so below the knee - where most samples
+    // of a mix sit - the pow is skipped without changing the output
+    static float gainFromDb(float gainDb)
+    {
+        return !juce::exactlyEqual(gainDb, 0.0f) ? juce::Decibels::decibelsToGain(gainDb) : 1.0f;
     }
 
     double sampleRate = 44100.0;
@@ -109,8 +291,14 @@ private:
     float attackMs = 10.0f;
     float releaseMs = 100.0f;
     float kneeDb = 6.0f;
+    float link = 1.0f;
+
+    // Detector state in either precision, per channel (equal while linked)
+    std::array<double, StereoLink::kMaxChannels> envelopes {};
+    std::array<float, StereoLink::kMaxChannels> channelGainReduction {};
+    bool doublePrecisionDetector = false;
+    GainRamp<> smoothedMakeup;
+    size_t maxBlockSize = 0;
 
-    float envelope = 0.0f;
-    float gainReduction = 0.0f;
-    juce::SmoothedValue<float> smoothedMakeup;
+    LookaheadDelay::Line* lookahead = nullptr;
 };
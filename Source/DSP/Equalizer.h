@@ -1,38 +1,63 @@
 #pragma once
 #include <juce_dsp/juce_dsp.h>
+#include "Biquad.h"
 
 class Equalizer
 {
 public:
+    // Same four biquads either way; the quality profile picks how they run
+    enum class Topology
+    {
+        transposedDirectFormII,  // float state and coefficients - cheapest
+        directFormIDouble        // double state and coefficients - no internal
+                                 // gain, least noise for low bands at high rates
+    };
+
+    static constexpr int kMaxChannels = 2;
+
     Equalizer() = default;
 
     void prepare(const juce::dsp::ProcessSpec& spec)
     {
         sampleRate = spec.sampleRate;
+        jassert(spec.numChannels <= (juce::uint32) kMaxChannels);
 
-        lowBand.prepare(spec);
-        lowMidBand.prepare(spec);
-        highMidBand.prepare(spec);
-        highBand.prepare(spec);
-
-        lowBand.reset();
-        lowMidBand.reset();
-        highMidBand.reset();
-        highBand.reset();
+        // Both topologies are always ready, so setTopology() can switch on
+        // the audio thread
+        if (precision == nullptr)
+            precision = std::make_unique<PrecisionBands>();
 
+        reset();
         updateAllCoefficients();
     }
 
     void reset()
     {
-        lowBand.reset();
-        lowMidBand.reset();
-        highMidBand.reset();
-        highBand.reset();
+        for (auto& band : bands)
+            band.reset();
+
+        if (precision != nullptr)
+            for (auto& band : precision->bands)
+                band.reset();
     }
 
+    // Both topologies are kept designed, so this is safe on the audio thread;
+    // filter state starts from silence after a switch
+    void setTopology(Topology newTopology)
+    {
+        if (newTopology == topology)
+            return;
+
+        topology = newTopology;
+        reset();
+    }
+
+    // Setters run for every processing slice, so only redesign on a change
     void setLowBand(float gain, float freq, bool isShelf)
     {
+        if (juce::exactlyEqual(gain, lowGain) && juce::exactlyEqual(freq, lowFreq) && isShelf == lowShelf)
+            return;
+
         lowGain = gain;
         lowFreq = freq;
         lowShelf = isShelf;
@@ -41,6 +66,9 @@ public:
 
     void setLowMidBand(float gain, float freq, float q)
     {
+        if (juce::exactlyEqual(gain, lowMidGain) && juce::exactlyEqual(freq, lowMidFreq) && juce::exactlyEqual(q, lowMidQ))
+            return;
+
         lowMidGain = gain;
         lowMidFreq = freq;
         lowMidQ = q;
@@ -49,6 +77,9 @@ public:
 
     void setHighMidBand(float gain, float freq, float q)
     {
+        if (juce::exactlyEqual(gain, highMidGain) && juce::exactlyEqual(freq, highMidFreq) && juce::exactlyEqual(q, highMidQ))
+            return;
+
         highMidGain = gain;
         highMidFreq = freq;
         highMidQ = q;
@@ -57,21 +88,74 @@ public:
 
     void setHighBand(float gain, float freq, bool isShelf)
     {
+        if (juce::exactlyEqual(gain, highGain) && juce::exactlyEqual(freq, highFreq) && isShelf == highShelf)
+            return;
+
         highGain = gain;
         highFreq = freq;
         highShelf = isShelf;
         updateHighCoefficients();
     }
 
+    // ==============================================================================
+    // Band designs - also used by FrequencyResponse to draw exactly these filters
+    // ==============================================================================
+    // T = double designs the same filter for the double-precision topology
+    template <typename T = float>
+    using Coefficients = std::array<T, 6>; // b0, b1, b2, a0, a1, a2
+
+    using BiquadCoefficients = Coefficients<float>;
+
+    template <typename T = float>
+    static Coefficients<T> designLowBand(double sampleRate, float gain, float freq, bool isShelf)
+    {
+        if (isShelf)
+            return juce::dsp::IIR::ArrayCoefficients<T>::makeLowShelf(
+                sampleRate, (T) freq, (T) 0.707, (T) juce::Decibels::decibelsToGain(gain));
+
+        return juce::dsp::IIR::ArrayCoefficients<T>::makePeakFilter(
+            sampleRate, (T) freq, (T) 0.707, (T) juce::Decibels::decibelsToGain(gain));
+    }
+
+    template <typename T = float>
+    static Coefficients<T> designPeakBand(double sampleRate, float gain, float freq, float q)
+    {
+        return juce::dsp::IIR::ArrayCoefficients<T>::makePeakFilter(
+            sampleRate, (T) freq, (T) q, (T) juce::Decibels::decibelsToGain(gain));
+    }
+
+    template <typename T = float>
+    static Coefficients<T> designHighBand(double sampleRate, float gain, float freq, bool isShelf)
+    {
+        if (isShelf)
+            return juce::dsp::IIR::ArrayCoefficients<T>::makeHighShelf(
+                sampleRate, (T) freq, (T) 0.707, (T) juce::Decibels::decibelsToGain(gain));
+
+        return juce::dsp::IIR::ArrayCoefficients<T>::makePeakFilter(
+            sampleRate, (T) freq, (T) 0.707, (T) juce::Decibels::decibelsToGain(gain));
+    }
+
     void process(juce::dsp::ProcessContextReplacing<float>& context)
     {
-        lowBand.process(context);
-        lowMidBand.process(context);
-        highMidBand.process(context);
-        highBand.process(context);
+        if (topology == Topology::directFormIDouble)
+        {
+            jassert(precision != nullptr);
+            auto& block = context.getOutputBlock();
+            const auto numChannels = juce::jmin(block.getNumChannels(), (size_t) kMaxChannels);
+
+            for (auto& band : precision->bands)
+                for (size_t ch = 0; ch < numChannels; ++ch)
+                    band.process(block.getChannelPointer(ch), block.getNumSamples(), ch);
+            return;
+        }
+
+        for (auto& band : bands)
+            band.process(context.getOutputBlock());
     }
 
 private:
+    // Coefficients are designed into std::arrays and copied into the inline
+    // biquads, so band updates on the audio thread never allocate
     void updateAllCoefficients()
     {
         updateLowCoefficients();
@@ -80,46 +164,84 @@ private:
         updateHighCoefficients();
     }
 
+    // Each band change redesigns both topologies (once prepared), so a switch
+    // never has to
     void updateLowCoefficients()
     {
-        if (lowShelf)
-        {
-            *lowBand.state = *juce::dsp::IIR::Coefficients<float>::makeLowShelf(
-                sampleRate, lowFreq, 0.707f, juce::Decibels::decibelsToGain(lowGain));
-        }
-        else
-        {
-            *lowBand.state = *juce::dsp::IIR::Coefficients<float>::makePeakFilter(
-                sampleRate, lowFreq, 0.707f, juce::Decibels::decibelsToGain(lowGain));
-        }
+        bands[0].setCoefficients(designLowBand(sampleRate, lowGain, lowFreq, lowShelf));
+        if (precision != nullptr)
+            precision->bands[0].setCoefficients(designLowBand<double>(sampleRate, lowGain, lowFreq, lowShelf));
     }
 
     void updateLowMidCoefficients()
     {
-        *lowMidBand.state = *juce::dsp::IIR::Coefficients<float>::makePeakFilter(
-            sampleRate, lowMidFreq, lowMidQ, juce::Decibels::decibelsToGain(lowMidGain));
+        bands[1].setCoefficients(designPeakBand(sampleRate, lowMidGain, lowMidFreq, lowMidQ));
+        if (precision != nullptr)
+            precision->bands[1].setCoefficients(designPeakBand<double>(sampleRate, lowMidGain, lowMidFreq, lowMidQ));
     }
 
     void updateHighMidCoefficients()
     {
-        *highMidBand.state = *juce::dsp::IIR::Coefficients<float>::makePeakFilter(
-            sampleRate, highMidFreq, highMidQ, juce::Decibels::decibelsToGain(highMidGain));
+        bands[2].setCoefficients(designPeakBand(sampleRate, highMidGain, highMidFreq, highMidQ));
+        if (precision != nullptr)
+            precision->bands[2].setCoefficients(designPeakBand<double>(sampleRate, highMidGain, highMidFreq, highMidQ));
     }
 
     void updateHighCoefficients()
     {
-        if (highShelf)
+        bands[3].setCoefficients(designHighBand(sampleRate, highGain, highFreq, highShelf));
+        if (precision != nullptr)
+            precision->bands[3].setCoefficients(designHighBand<double>(sampleRate, highGain, highFreq, highShelf));
+    }
+
+    // Direct form I in double: y = b0 x + b1 x1 + b2 x2 - a1 y1 - a2 y2
+    struct PrecisionBiquad
+    {
+        void setCoefficients(const Coefficients<double>& c)
         {
-            *highBand.state = *juce::dsp::IIR::Coefficients<float>::makeHighShelf(
-                sampleRate, highFreq, 0.707f, juce::Decibels::decibelsToGain(highGain));
+            const double a0 = c[3];
+            b0 = c[0] / a0; b1 = c[1] / a0; b2 = c[2] / a0;
+            a1 = c[4] / a0; a2 = c[5] / a0;
         }
-        else
+
+        void reset() { state.fill({}); }
+
+        void process(float* x, size_t numSamples, size_t channel)
         {
-            *highBand.state = *juce::dsp::IIR::Coefficients<float>::makePeakFilter(
-                sampleRate, highFreq, 0.707f, juce::Decibels::decibelsToGain(highGain));
+            auto [x1, x2, y1, y2] = state[channel];
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                const double in = x[i];
+                const double out = b0 * in + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+
+                x2 = x1; x1 = in;
+                y2 = y1; y1 = out;
+                x[i] = (float) out;
+            }
+
+            state[channel] = { x1, x2, y1, y2 };
         }
-    }
 
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+
+        struct History { double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0; };
+        std::array<History, kMaxChannels> state {};
+    };
+
+    // Offline profile: cold while tracking, so the doubles live outside the
+    // stage and stay out of the cache lines the realtime path uses
+    struct PrecisionBands
+    {
+        std::array<PrecisionBiquad, 4> bands;
+    };
+
+    // Hot: what process() reads every slice. Low, low-mid, high-mid, high.
+    Topology topology = Topology::transposedDirectFormII;
+    std::array<Biquad, 4> bands;
+    std::unique_ptr<PrecisionBands> precision; // directFormIDouble topology
+
+    // Cold: only read when a band setting changes
     double sampleRate = 44100.0;
 
     // Low band
@@ -141,8 +263,4 @@ private:
     float highGain = 0.0f;
     float highFreq = 12000.0f;
     bool highShelf = true;
-
-    using Filter = juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>,
-                                                   juce::dsp::IIR::Coefficients<float>>;
-    Filter lowBand, lowMidBand, highMidBand, highBand;
 };
@@ -0,0 +1,127 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Block-ramp parameter smoothing.
+ *
+ * The same ramps as juce::SmoothedValue (Linear or Multiplicative, reaching
+ * the target after a fixed time), but produced a block at a time: next()
+ * writes the next numSamples values into a buffer the stage multiplies by,
+ * instead of the stage calling getNextValue() inside its sample loop. The
+ * linear ramp is written as start + step * (i + 1), with no dependency from
+ * one sample to the next, so the fill and the stage's multiply both
+ * vectorise. Once the target is reached isSmoothing() is false and the
+ * stage uses getCurrentValue() as a plain scalar.
+ */
+template <typename SmoothingType = juce::ValueSmoothingTypes::Linear>
+class GainRamp
+{
+public:
+    static constexpr bool isMultiplicative = std::is_same_v<SmoothingType, juce::ValueSmoothingTypes::Multiplicative>;
+
+    GainRamp() = default;
+
+    void prepare(double sampleRate, double rampLengthSeconds, int maximumBlockSize)
+    {
+        stepsToTarget = (int) std::floor(rampLengthSeconds * sampleRate);
+        ramp.assign((size_t) maximumBlockSize, currentValue);
+        setCurrentAndTargetValue(targetValue);
+    }
+
+    void setCurrentAndTargetValue(float value)
+    {
+        currentValue = targetValue = value;
+        countdown = 0;
+    }
+
+    void setTargetValue(float value)
+    {
+        if (juce::exactlyEqual(value, targetValue))
+            return;
+
+        if (stepsToTarget <= 0)
+        {
+            setCurrentAndTargetValue(value);
+            return;
+        }
+
+        // A multiplicative ramp can't start from or pass through zero
+        jassert(!isMultiplicative || (value > 0.0f && currentValue > 0.0f));
+
+        targetValue = value;
+        countdown = stepsToTarget;
+
+        if constexpr (isMultiplicative)
+            step = std::exp((std::log(targetValue) - std::log(currentValue)) / (float) countdown);
+        else
+            step = (targetValue - currentValue) / (float) countdown;
+    }
+
+    float getTargetValue() const { return targetValue; }
+    float getCurrentValue() const { return currentValue; }
+    bool isSmoothing() const { return countdown > 0; }
+
+    // The next numSamples values of the ramp (at most the prepared block size).
+    // Past the end of the ramp the buffer holds the target.
+    const float* next(int numSamples)
+    {
+        jassert(numSamples <= (int) ramp.size());
+        float* values = ramp.data();
+
+        if (numSamples <= 0)
+            return values;
+
+        const int rampSamples = juce::jmin(numSamples, countdown);
+
+        if constexpr (isMultiplicative)
+        {
+            float value = currentValue;
+            for (int i = 0; i < rampSamples; ++i)
+                values[i] = value *= step;
+        }
+        else
+        {
+            const float start = currentValue;
+            for (int i = 0; i < rampSamples; ++i)
+                values[i] = start + step * (float) (i + 1);
+        }
+
+        countdown -= rampSamples;
+        currentValue = countdown > 0 ? values[rampSamples - 1] : targetValue;
+
+        for (int i = rampSamples; i < numSamples; ++i)
+            values[i] = targetValue;
+
+        return values;
+    }
+
+    void skip(int numSamples)
+    {
+        if (countdown <= 0)
+            return;
+
+        if (numSamples >= countdown)
+        {
+            setCurrentAndTargetValue(targetValue);
+            return;
+        }
+
+        if constexpr (isMultiplicative)
+            currentValue *= std::pow(step, (float) numSamples);
+        else
+            currentValue += step * (float) numSamples;
+
+        countdown -= numSamples;
+    }
+
+private:
+    std::vector<float> ramp;
+    float currentValue = 1.0f;
+    float targetValue = 1.0f;
+    float step = 0.0f;
+    int countdown = 0;
+    int stepsToTarget = 0;
+};
@@ -1,5 +1,7 @@
 #pragma once
 #include <juce_dsp/juce_dsp.h>
+#include "LookaheadDelay.h"
+#include "StereoLink.h"
 
 class Gate
 {
@@ -9,16 +11,12 @@ public:
     void prepare(const juce::dsp::ProcessSpec& spec)
     {
         sampleRate = spec.sampleRate;
-        envelope = 0.0f;
-        currentGain = 1.0f;
-        gainReduction = 0.0f;
+        channels.fill({});
     }
 
     void reset()
     {
-        envelope = 0.0f;
-        currentGain = 1.0f;
-        gainReduction = 0.0f;
+        channels.fill({});
     }
 
     void setThreshold(float dB) { thresholdDb = dB; }
@@ -26,18 +24,108 @@ public:
     void setRelease(float ms) { releaseMs = ms; }
     void setRange(float dB) { rangeDb = dB; }
 
-    float getGainReduction() const { return gainReduction; }
+    // Time the gate stays open after the detector drops below the close threshold
+    void setHold(float ms) { holdMs = ms; }
+
+    // The gate opens at the threshold and closes this far below it
+    void setHysteresis(float dB) { hysteresisDb = dB; }
+
+    // 100%: one gate keyed by the louder channel; less gates each channel on its own
+    void setStereoLink(float percent) { link = juce::jlimit(0.0f, 1.0f, percent * 0.01f); }
+
+    // Envelope and gain smoothing in double (offline quality profile), for
+    // long time constants at high sample rates (see Compressor)
+    void setDoublePrecisionDetector(bool enabled) { doublePrecisionDetector = enabled; }
+
+    // Delay line the gain is applied through (nullptr: no lookahead)
+    void setLookahead(LookaheadDelay::Line* line) { lookahead = line; }
+    LookaheadDelay::Line* getLookahead() const { return lookahead; }
+
+    // Deepest gain reduction over the last block (dB), of either channel
+    float getGainReduction() const { return juce::jmin(channels[0].gainReduction, channels[1].gainReduction); }
+
+    // Per channel of the last block (a mono block reports its channel on both)
+    float getGainReduction(size_t channel) const { return channels[channel].gainReduction; }
+
+    // Louder detector envelope at the end of the last block (dB)
+    float getDetectorLevel() const
+    {
+        return juce::Decibels::gainToDecibels((float) juce::jmax(channels[0].envelope, channels[1].envelope));
+    }
+
+    // Static curve: a closed gate opens at the threshold, an open one only
+    // closes below threshold - hysteresis. process() makes the same comparisons
+    // on the linear envelope, and also holds the gate open for the hold time.
+    static float computeStaticGain(float inputDb, float thresholdDb, float rangeDb,
+                                   float hysteresisDb = 0.0f, bool isOpen = false)
+    {
+        const float switchDb = isOpen ? thresholdDb - hysteresisDb : thresholdDb;
+        return inputDb < switchDb ? rangeDb : 0.0f;
+    }
 
     void process(juce::dsp::ProcessContextReplacing<float>& context)
+    {
+        // Only a stereo pair has channels to unlink
+        const bool linked = link >= 1.0f || context.getOutputBlock().getNumChannels() != StereoLink::kMaxChannels;
+
+        if (linked && doublePrecisionDetector)
+            processLinked<double>(context);
+        else if (linked)
+            processLinked<float>(context);
+        else if (doublePrecisionDetector)
+            processPerChannel<double>(context);
+        else
+            processPerChannel<float>(context);
+    }
+
+private:
+    // Detector, hold and gain state of one channel (all equal while linked)
+    struct ChannelState
+    {
+        double envelope = 0.0;      // Either precision
+        double gain = 1.0;
+        bool isOpen = false;
+        int holdRemaining = 0;
+        float gainReduction = 0.0f;
+    };
+
+    // Open at the threshold; close below the hysteresis band once the hold has run out
+    template <typename Detector>
+    static void updateOpen(ChannelState& state, Detector detector, Detector openThreshold, Detector closeThreshold, int holdSamples)
+    {
+        if (detector >= openThreshold)
+        {
+            state.isOpen = true;
+            state.holdRemaining = holdSamples;
+        }
+        else if (state.isOpen && detector < closeThreshold)
+        {
+            if (state.holdRemaining > 0)
+                --state.holdRemaining;
+            else
+                state.isOpen = false;
+        }
+    }
+
+    template <typename Detector>
+    void processLinked(juce::dsp::ProcessContextReplacing<float>& context)
     {
         auto& block = context.getOutputBlock();
         const auto numChannels = block.getNumChannels();
         const auto numSamples = block.getNumSamples();
 
-        float threshold = juce::Decibels::decibelsToGain(thresholdDb);
-        float rangeGain = juce::Decibels::decibelsToGain(rangeDb);
-        float attackCoef = std::exp(-1.0f / (static_cast<float>(sampleRate) * attackMs * 0.001f));
-        float releaseCoef = std::exp(-1.0f / (static_cast<float>(sampleRate) * releaseMs * 0.001f));
+        const Detector one = 1;
+        Detector openThreshold = juce::Decibels::decibelsToGain((Detector) thresholdDb);
+        Detector closeThreshold = juce::Decibels::decibelsToGain((Detector) (thresholdDb - hysteresisDb));
+        const int holdSamples = static_cast<int>(sampleRate * holdMs * 0.001f);
+        Detector rangeGain = juce::Decibels::decibelsToGain((Detector) rangeDb);
+        Detector attackCoef = std::exp(-one / (static_cast<Detector>(sampleRate) * (Detector) attackMs * (Detector) 0.001));
+        Detector releaseCoef = std::exp(-one / (static_cast<Detector>(sampleRate) * (Detector) releaseMs * (Detector) 0.001));
+
+        // Carry on from the louder channel when the link has just come up
+        ChannelState state = channels[channels[1].envelope > channels[0].envelope ? 1 : 0];
+        Detector detector = (Detector) state.envelope;
+        Detector gain = (Detector) state.gain;
 
         float maxGR = 0.0f;
 
@@ -51,46 +139,125 @@ public:
             }
 
             // Envelope follower
-            if (inputLevel > envelope)
-                envelope = attackCoef * envelope + (1.0f - attackCoef) * inputLevel;
+            if (inputLevel > detector)
+                detector = attackCoef * detector + (one - attackCoef) * inputLevel;
             else
-                envelope = releaseCoef * envelope + (1.0f - releaseCoef) * inputLevel;
+                detector = releaseCoef * detector + (one - releaseCoef) * inputLevel;
 
-            // Calculate gate gain
-            float targetGain = 1.0f;
-            if (envelope < threshold)
-            {
-                targetGain = rangeGain;
-            }
+            updateOpen(state, detector, openThreshold, closeThreshold, holdSamples);
+
+            Detector targetGain = state.isOpen ? one : rangeGain;
 
             // Smooth gain changes
-            if (targetGain < currentGain)
-                currentGain = attackCoef * currentGain + (1.0f - attackCoef) * targetGain;
+            if (targetGain < gain)
+                gain = attackCoef * gain + (one - attackCoef) * targetGain;
             else
-                currentGain = releaseCoef * currentGain + (1.0f - releaseCoef) * targetGain;
+                gain = releaseCoef * gain + (one - releaseCoef) * targetGain;
 
-            // Apply gain
+            // Apply gain (to the delayed signal with lookahead)
+            const float sampleGain = (float) gain;
             for (size_t ch = 0; ch < numChannels; ++ch)
             {
-                block.getChannelPointer(ch)[sample] *= currentGain;
+                float* channel = block.getChannelPointer(ch);
+                const float dry = lookahead != nullptr ? lookahead->exchange(ch, channel[sample]) : channel[sample];
+                channel[sample] = dry * sampleGain;
             }
 
             // Track max gain reduction
-            float gr = 1.0f - currentGain;
+            float gr = 1.0f - sampleGain;
             if (gr > maxGR) maxGR = gr;
         }
 
-        gainReduction = juce::Decibels::gainToDecibels(1.0f - maxGR + 0.0001f);
+        state.envelope = detector;
+        state.gain = gain;
+        state.gainReduction = juce::Decibels::gainToDecibels(1.0f - maxGR + 0.0001f);
+        channels.fill(state);
+    }
+
+    // Envelopes and gain smoothing of both channels in Lanes registers; the
+    // open / hold decisions stay per channel
+    template <typename Detector>
+    void processPerChannel(juce::dsp::ProcessContextReplacing<float>& context)
+    {
+        using Lanes = StereoLink::Lanes<Detector>;
+
+        auto& block = context.getOutputBlock();
+        const auto numSamples = block.getNumSamples();
+        jassert(block.getNumChannels() == StereoLink::kMaxChannels);
+
+        const Detector one = 1;
+        const Detector openThreshold = juce::Decibels::decibelsToGain((Detector) thresholdDb);
+        const Detector closeThreshold = juce::Decibels::decibelsToGain((Detector) (thresholdDb - hysteresisDb));
+        const int holdSamples = static_cast<int>(sampleRate * holdMs * 0.001f);
+        const Detector rangeGain = juce::Decibels::decibelsToGain((Detector) rangeDb);
+        const auto attack = Lanes::expand(std::exp(-one / (static_cast<Detector>(sampleRate) * (Detector) attackMs * (Detector) 0.001)));
+        const auto release = Lanes::expand(std::exp(-one / (static_cast<Detector>(sampleRate) * (Detector) releaseMs * (Detector) 0.001)));
+        const Detector linkAmount = (Detector) link;
+
+        Lanes detector, gain;
+        for (size_t ch = 0; ch < StereoLink::kMaxChannels; ++ch)
+        {
+            detector.set(ch, (Detector) channels[ch].envelope);
+            gain.set(ch, (Detector) channels[ch].gain);
+        }
+
+        std::array<float, StereoLink::kMaxChannels> maxGR {};
+
+        for (size_t sample = 0; sample < numSamples; ++sample)
+        {
+            std::array<float, StereoLink::kMaxChannels> levels;
+            for (size_t ch = 0; ch < StereoLink::kMaxChannels; ++ch)
+                levels[ch] = std::abs(block.getChannelPointer(ch)[sample]);
+
+            const Detector loudest = (Detector) juce::jmax(levels[0], levels[1]);
+
+            Lanes input;
+            for (size_t ch = 0; ch < StereoLink::kMaxChannels; ++ch)
+                input.set(ch, StereoLink::blend((Detector) levels[ch], loudest, linkAmount));
+
+            detector.follow(input, attack, release);
+
+            Lanes targetGain;
+            for (size_t ch = 0; ch < StereoLink::kMaxChannels; ++ch)
+            {
+                updateOpen(channels[ch], detector.get(ch), openThreshold, closeThreshold, holdSamples);
+                targetGain.set(ch, channels[ch].isOpen ? one : rangeGain);
+            }
+
+            // Closing uses the attack time, opening the release (as linked)
+            gain.follow(targetGain, release, attack);
+
+            for (size_t ch = 0; ch < StereoLink::kMaxChannels; ++ch)
+            {
+                const float sampleGain = (float) gain.get(ch);
+                float* channel = block.getChannelPointer(ch);
+                const float dry = lookahead != nullptr ? lookahead->exchange(ch, channel[sample]) : channel[sample];
+                channel[sample] = dry * sampleGain;
+
+                maxGR[ch] = juce::jmax(maxGR[ch], 1.0f - sampleGain);
+            }
+        }
+
+        for (size_t ch = 0; ch < StereoLink::kMaxChannels; ++ch)
+        {
+            channels[ch].envelope = detector.get(ch);
+            channels[ch].gain = gain.get(ch);
+            channels[ch].gainReduction = juce::Decibels::gainToDecibels(1.0f - maxGR[ch] + 0.0001f);
+        }
     }
 
-private:
     double sampleRate = 44100.0;
     float thresholdDb = -40.0f;
     float attackMs = 1.0f;
     float releaseMs = 100.0f;
     float rangeDb = -80.0f;
+    float holdMs = 0.0f;
+    float hysteresisDb = 0.0f;
+
+    float link = 1.0f;
+    bool doublePrecisionDetector = false;
+
+    std::array<ChannelState, StereoLink::kMaxChannels> channels;
 
-    float envelope = 0.0f;
-    float currentGain = 1.0f;
-    float gainReduction = 0.0f;
+    LookaheadDelay::Line* lookahead = nullptr;
 };
@@ -1,5 +1,6 @@
 #pragma once
 #include <juce_dsp/juce_dsp.h>
+#include "Biquad.h"
 
 class HighPassFilter
 {
@@ -9,13 +10,9 @@ public:
     void prepare(const juce::dsp::ProcessSpec& spec)
     {
         sampleRate = spec.sampleRate;
+        jassert(spec.numChannels <= (juce::uint32) Biquad::kMaxChannels);
 
-        for (auto& filter : filters)
-        {
-            filter.prepare(spec);
-            filter.reset();
-        }
-
+        reset();
         updateCoefficients();
     }
 
@@ -27,7 +24,7 @@ public:
 
     void setFrequency(float freq)
     {
-        if (frequency != freq)
+        if (!juce::exactlyEqual(frequency, freq))
         {
             frequency = freq;
             updateCoefficients();
@@ -37,7 +34,7 @@ public:
     void setSlope(int slopeIndex)
     {
         // 0 = 12 dB/oct (2 poles), 1 = 18 dB/oct (3 poles), 2 = 24 dB/oct (4 poles)
-        int newOrder = (slopeIndex + 1) * 2;
+        int newOrder = getNumSections(slopeIndex) * 2;
         if (filterOrder != newOrder)
         {
             filterOrder = newOrder;
@@ -45,6 +42,14 @@ public:
         }
     }
 
+    // Section design and cascade length - also used by FrequencyResponse
+    static std::array<float, 6> designSection(double sampleRate, float freq)
+    {
+        return juce::dsp::IIR::ArrayCoefficients<float>::makeHighPass(sampleRate, freq);
+    }
+
+    static int getNumSections(int slopeIndex) { return slopeIndex + 1; }
+
     void process(juce::dsp::ProcessContextReplacing<float>& context)
     {
         // Apply cascaded filters based on order
@@ -52,26 +57,28 @@ public:
 
         for (int i = 0; i < numFiltersToUse && i < maxFilters; ++i)
         {
-            filters[i].process(context);
+            filters[(size_t) i].process(context.getOutputBlock());
         }
     }
 
 private:
     void updateCoefficients()
     {
-        auto coeffs = juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, frequency);
+        // Array design into the inline sections: no allocation on the audio thread
+        const auto coeffs = designSection(sampleRate, frequency);
 
         for (auto& filter : filters)
         {
-            *filter.state = *coeffs;
+            filter.setCoefficients(coeffs);
         }
     }
 
-    double sampleRate = 44100.0;
-    float frequency = 80.0f;
+    static constexpr int maxFilters = 4;
+
+    // Hot: the cascade and the order read every slice
+    std::array<Biquad, maxFilters> filters;
     int filterOrder = 4; // 24 dB/oct default
 
-    static constexpr int maxFilters = 4;
-    std::array<juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>,
-               juce::dsp::IIR::Coefficients<float>>, maxFilters> filters;
+    double sampleRate = 44100.0;
+    float frequency = 80.0f;
 };
@@ -1,34 +1,152 @@
 #pragma once
 #include <juce_dsp/juce_dsp.h>
+#include "GainRamp.h"
+#include "MidSide.h"
+#include "Saturation.h"
 
 class InputStage
 {
 public:
+    // Oversampled drive (the offline quality profile): 2x per stage
+    static constexpr int kOversamplingStages = 2;
+    static constexpr int kOversamplingFactor = 1 << kOversamplingStages;
+
     InputStage() = default;
 
     void prepare(const juce::dsp::ProcessSpec& spec)
     {
         sampleRate = spec.sampleRate;
-        smoothedGain.reset(spec.sampleRate, 0.02);
-        smoothedGain.setCurrentAndTargetValue(1.0f);
+        maxBlockSize = (size_t) spec.maximumBlockSize;
+        smoothedGain.prepare(spec.sampleRate, 0.02, (int) spec.maximumBlockSize);
+        smoothedGain.setCurrentAndTargetValue(getGainTarget());
+
+        saturation.prepare(spec);
+
+        // Both drive paths are always ready, so setOversampling() can switch on
+        // the audio thread. Integer latency keeps the reported latency exact.
+        offline = std::make_unique<Oversampled>((size_t) spec.numChannels);
+        offline->oversampler.initProcessing((size_t) spec.maximumBlockSize);
+        offline->saturation.setCurve(saturation.getCurve());
+        offline->saturation.prepare({ spec.sampleRate * kOversamplingFactor,
+                                      spec.maximumBlockSize * (juce::uint32) kOversamplingFactor,
+                                      spec.numChannels });
     }
 
     void reset()
     {
         smoothedGain.setCurrentAndTargetValue(smoothedGain.getTargetValue());
+        saturation.reset();
+
+        if (offline != nullptr)
+        {
+            offline->saturation.reset();
+            offline->oversampler.reset();
+        }
+    }
+
+    // 1 (ADAA alone, no latency) or kOversamplingFactor. While oversampling,
+    // the undriven path is delayed by the caller instead (needsInputDelay()),
+    // so the latency does not depend on the saturation choice.
+    void setOversampling(int factor)
+    {
+        jassert(factor == 1 || factor == kOversamplingFactor);
+        const bool enabled = factor > 1;
+
+        if (enabled != oversampling)
+        {
+            oversampling = enabled;
+            reset();
+        }
+    }
+
+    int getLatencySamples() const
+    {
+        return oversampling && offline != nullptr ? juce::roundToInt(offline->oversampler.getLatencyInSamples()) : 0;
     }
 
     void setGain(float dB)
     {
-        smoothedGain.setTargetValue(juce::Decibels::decibelsToGain(dB));
+        levelGain = juce::Decibels::decibelsToGain(dB);
+        smoothedGain.setTargetValue(getGainTarget());
+    }
+
+    // Drive into the saturation curve (Off bypasses it entirely). It rides
+    // on the level ramp, so the curve gets a block that is already driven.
+    void setDrive(float dB)
+    {
+        driveGain = juce::Decibels::decibelsToGain(dB);
+        smoothedGain.setTargetValue(getGainTarget());
+    }
+
+    void setSaturation(Saturation::Curve curve)
+    {
+        // The oversampler only runs while driving; start it from silence
+        // rather than from whatever it held when the drive was last on
+        if (oversampling && offline != nullptr && !saturation.isActive() && curve != Saturation::Curve::off)
+            offline->oversampler.reset();
+
+        const bool wasActive = saturation.isActive();
+        saturation.setCurve(curve);
+
+        if (offline != nullptr)
+            offline->saturation.setCurve(curve);
+
+        // Switching the curve in or out steps anyway; ramping the drive out
+        // would instead pass it unsaturated for the length of the ramp
+        if (saturation.isActive() != wasActive)
+            smoothedGain.setCurrentAndTargetValue(getGainTarget());
     }
 
+    // Oversampling but undriven: the oversampler is skipped, and the caller
+    // delays the slice by getLatencySamples() (the input lookahead tap) so
+    // the latency does not depend on the saturation choice
+    bool needsInputDelay() const { return oversampling && !saturation.isActive(); }
+
     void setPhaseInvert(bool invert) { phaseInvert = invert; }
     void setPad(bool enabled) { padEnabled = enabled; }
 
+    // Leave the block mid/side encoded for the chain (stereo only) - the
+    // matrix rides along with the gain multiply instead of costing a pass
+    void setMidSideOutput(bool enabled) { midSideOutput = enabled; }
+
+    // Leave gains that commute with everything up to OutputStage for it to
+    // apply inside its matrix: level (gain ramp and pad) when nothing in
+    // between depends on level, polarity when nothing in between is
+    // asymmetric. With both deferred and no mid/side output this stage
+    // makes no pass over the block at all.
+    void setDeferredGains(bool level, bool polarity)
+    {
+        deferLevel = level;
+        deferPolarity = polarity;
+    }
+
+    // What the last slice left for OutputStage: ramp[i] * value per sample,
+    // or value alone when ramp is nullptr. The ramp is valid until the next
+    // process() call.
+    struct CarriedGain
+    {
+        const float* ramp = nullptr;
+        float value = 1.0f;
+    };
+
+    CarriedGain getCarriedGain() const { return carried; }
+
     void process(juce::dsp::ProcessContextReplacing<float>& context)
     {
         auto& block = context.getOutputBlock();
+        const auto numSamples = block.getNumSamples();
+
+        // Ramps are produced at most one prepared block at a time (and only
+        // the last slice's deferred gain survives for OutputStage)
+        jassert(maxBlockSize > 0);
+        jassert(numSamples <= maxBlockSize || (!deferLevel && !deferPolarity));
+        for (size_t start = 0; start < numSamples; start += maxBlockSize)
+            processSlice(block.getSubBlock(start, juce::jmin(maxBlockSize, numSamples - start)));
+    }
+
+private:
+    void processSlice(juce::dsp::AudioBlock<float> block)
+    {
         const auto numChannels = block.getNumChannels();
         const auto numSamples = block.getNumSamples();
 
@@ -36,20 +154,131 @@ public:
         float padGain = padEnabled ? juce::Decibels::decibelsToGain(-20.0f) : 1.0f;
         float phaseMultiplier = phaseInvert ? -1.0f : 1.0f;
 
-        for (size_t sample = 0; sample < numSamples; ++sample)
+        // nullptr once the gain has settled - the whole slice then takes one scalar
+        const float* levelRamp = smoothedGain.isSmoothing() ? smoothedGain.next((int) numSamples) : nullptr;
+        const float level = levelRamp != nullptr ? 1.0f : smoothedGain.getCurrentValue();
+
+        // Split into what is applied here and what OutputStage applies
+        const float deferredStatic = (deferLevel ? padGain : 1.0f) * (deferPolarity ? phaseMultiplier : 1.0f);
+        const float staticGain = (deferLevel ? 1.0f : padGain) * (deferPolarity ? 1.0f : phaseMultiplier);
+
+        carried = deferLevel ? CarriedGain { levelRamp, level * deferredStatic }
+                             : CarriedGain { nullptr, deferredStatic };
+
+        const float* gainRamp = deferLevel ? nullptr : levelRamp;
+        const float gain = (deferLevel ? 1.0f : level) * staticGain;
+
+        if (saturation.isActive())
+        {
+            // Neither level nor (for the asymmetric curve) polarity commutes with it
+            jassert(!deferLevel && (!deferPolarity || saturation.getCurve() != Saturation::Curve::tube));
+
+            // The curve runs on L/R, so the mid/side matrix can only follow
+            // it. The gain carries the drive.
+            applyGain(block, gainRamp, staticGain, gain);
+            saturate(block);
+
+            if (midSideOutput && numChannels >= 2)
+                MidSide::encode(block);
+            return;
+        }
+
+        if (midSideOutput && numChannels >= 2)
         {
-            float gain = smoothedGain.getNextValue() * padGain * phaseMultiplier;
+            float* leftChannel = block.getChannelPointer(0);
+            float* rightChannel = block.getChannelPointer(1);
+
+            const auto encode = [&](size_t sample, float g)
+            {
+                float left = leftChannel[sample];
+                float right = rightChannel[sample];
+
+                leftChannel[sample] = (left + right) * g;
+                rightChannel[sample] = (left - right) * g;
+            };
 
-            for (size_t ch = 0; ch < numChannels; ++ch)
+            if (gainRamp != nullptr)
             {
-                block.getChannelPointer(ch)[sample] *= gain;
+                for (size_t sample = 0; sample < numSamples; ++sample)
+                    encode(sample, gainRamp[sample] * staticGain * 0.5f);
+            }
+            else
+            {
+                for (size_t sample = 0; sample < numSamples; ++sample)
+                    encode(sample, gain * 0.5f);
+            }
+            return;
+        }
+
+        applyGain(block, gainRamp, staticGain, gain);
+    }
+
+    void saturate(juce::dsp::AudioBlock<float>& block)
+    {
+        if (!oversampling)
+        {
+            saturation.process(block);
+            return;
+        }
+
+        auto upsampled = offline->oversampler.processSamplesUp(block);
+        offline->saturation.process(upsampled);
+        offline->oversampler.processSamplesDown(block);
+    }
+
+    // Level, times the drive while the curve is on
+    float getGainTarget() const { return levelGain * (saturation.isActive() ? driveGain : 1.0f); }
+
+    static void applyGain(juce::dsp::AudioBlock<float>& block, const float* gainRamp, float staticGain, float gain)
+    {
+        const int numSamples = (int) block.getNumSamples();
+
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+        {
+            float* channel = block.getChannelPointer(ch);
+
+            if (gainRamp != nullptr)
+            {
+                juce::FloatVectorOperations::multiply(channel, gainRamp, numSamples);
+                if (!juce::exactlyEqual(staticGain, 1.0f))
+                    juce::FloatVectorOperations::multiply(channel, staticGain, numSamples);
+            }
+            else if (!juce::exactlyEqual(gain, 1.0f))
+            {
+                juce::FloatVectorOperations::multiply(channel, gain, numSamples);
             }
         }
     }
 
-private:
     double sampleRate = 44100.0;
-    juce::SmoothedValue<float> smoothedGain;
+    size_t maxBlockSize = 0;
+    GainRamp<> smoothedGain;
+    float levelGain = 1.0f;
+    float driveGain = 1.0f;
+    Saturation saturation;
+
+    // Offline profile: the same curve at kOversamplingFactor x the rate.
+    // Cold while tracking, so it lives outside the stage and its filter
+    // state stays out of the cache lines the realtime path uses.
+    struct Oversampled
+    {
+        explicit Oversampled(size_t numChannels)
+            : oversampler(numChannels, (size_t) kOversamplingStages,
+                          juce::dsp::Oversampling<float>::filterHalfBandFIREquiripple, true, true)
+        {
+        }
+
+        juce::dsp::Oversampling<float> oversampler;
+        Saturation saturation;
+    };
+
+    std::unique_ptr<Oversampled> offline;
+    bool oversampling = false;
+
     bool phaseInvert = false;
     bool padEnabled = false;
+    bool midSideOutput = false;
+    bool deferLevel = false;
+    bool deferPolarity = false;
+    CarriedGain carried;
 };
@@ -0,0 +1,77 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+
+/**
+ * ITU-R BS.1770 K-weighting: a high-shelf pre-filter followed by the RLB
+ * high-pass. Coefficients are designed for the actual sample rate instead of
+ * using the 48 kHz table from the standard.
+ */
+namespace KWeighting
+{
+    struct Biquad
+    {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+        double z1 = 0.0, z2 = 0.0;
+
+        double process(double x)
+        {
+            const double y = b0 * x + z1;
+            z1 = b1 * x - a1 * y + z2;
+            z2 = b2 * x - a2 * y;
+            return y;
+        }
+
+        void reset() { z1 = z2 = 0.0; }
+    };
+
+    // One channel of K-weighting
+    struct Filter
+    {
+        std::array<Biquad, 2> stages;
+
+        double process(double x) { return stages[1].process(stages[0].process(x)); }
+        void reset() { stages[0].reset(); stages[1].reset(); }
+    };
+
+    inline Filter design(double sampleRate)
+    {
+        Filter filter;
+
+        // Stage 1: pre-filter (head acoustics high shelf)
+        {
+            const double f0 = 1681.974450955533;
+            const double gainDb = 3.999843853973347;
+            const double q = 0.7071752369554196;
+
+            const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+            const double vh = std::pow(10.0, gainDb / 20.0);
+            const double vb = std::pow(vh, 0.4996667741545416);
+            const double a0 = 1.0 + k / q + k * k;
+
+            auto& shelf = filter.stages[0];
+            shelf.b0 = (vh + vb * k / q + k * k) / a0;
+            shelf.b1 = 2.0 * (k * k - vh) / a0;
+            shelf.b2 = (vh - vb * k / q + k * k) / a0;
+            shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+            shelf.a2 = (1.0 - k / q + k * k) / a0;
+        }
+
+        // Stage 2: RLB weighting (high-pass)
+        {
+            const double f0 = 38.13547087602444;
+            const double q = 0.5003270373238773;
+
+            const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+            const double a0 = 1.0 + k / q + k * k;
+
+            auto& highPass = filter.stages[1];
+            highPass.b0 = 1.0;
+            highPass.b1 = -2.0;
+            highPass.b2 = 1.0;
+            highPass.a1 = 2.0 * (k * k - 1.0) / a0;
+            highPass.a2 = (1.0 - k / q + k * k) / a0;
+        }
+
+        return filter;
+    }
+}
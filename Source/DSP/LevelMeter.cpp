@@ -0,0 +1,2 @@
+#include "LevelMeter.h"
+// Implementation in header (inline class)
@@ -0,0 +1,192 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+
+/**
+ * Peak / RMS / over meter for one metering point (strip input or output).
+ *
+ * The audio thread makes one fused pass per channel that yields the block's
+ * peak, sum of squares and number of samples at or above 0 dBFS. Ballistics
+ * (peak fall-back, peak hold, RMS integration) then run once per block on
+ * those three numbers rather than per sample, and the results are published
+ * through atomics for the editor to read at any time.
+ */
+class LevelMeter
+{
+public:
+    static constexpr int kMaxChannels = 2;
+
+    LevelMeter() = default;
+
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+        reset();
+    }
+
+    void reset()
+    {
+        for (auto& channel : channels)
+        {
+            channel.peak = channel.hold = channel.meanSquare = 0.0f;
+            channel.holdRemaining = 0.0;
+            channel.published.peak.store(0.0f);
+            channel.published.hold.store(0.0f);
+            channel.published.rms.store(0.0f);
+        }
+    }
+
+    // Audio thread
+    void process(const juce::AudioBuffer<float>& buffer, int numChannels, int numSamples)
+    {
+        if (numSamples <= 0)
+            return;
+
+        const double blockSeconds = numSamples / sampleRate;
+        const float fall = juce::Decibels::decibelsToGain(-kFallDbPerSecond * (float) blockSeconds);
+        const float rmsCoef = (float) std::exp(-blockSeconds / kRmsSeconds);
+
+        for (int ch = 0; ch < juce::jmin(numChannels, kMaxChannels); ++ch)
+        {
+            const auto block = measure(buffer.getReadPointer(ch), numSamples);
+            auto& channel = channels[(size_t) ch];
+
+            // Instant attack, constant dB/s fall-back
+            channel.peak = juce::jmax(block.peak, channel.peak * fall);
+
+            // The hold marker sits on the highest peak until the hold time runs out
+            if (block.peak >= channel.hold)
+            {
+                channel.hold = block.peak;
+                channel.holdRemaining = kHoldSeconds;
+            }
+            else if (channel.holdRemaining > 0.0)
+            {
+                channel.holdRemaining -= blockSeconds;
+            }
+            else
+            {
+                channel.hold = juce::jmax(channel.peak, channel.hold * fall);
+            }
+
+            const float blockMeanSquare = block.sumSquares / (float) numSamples;
+            channel.meanSquare = rmsCoef * channel.meanSquare + (1.0f - rmsCoef) * blockMeanSquare;
+
+            channel.published.peak.store(channel.peak, std::memory_order_relaxed);
+            channel.published.hold.store(channel.hold, std::memory_order_relaxed);
+            channel.published.rms.store(std::sqrt(channel.meanSquare), std::memory_order_relaxed);
+            if (block.overs > 0)
+                channel.published.overs.fetch_add(block.overs, std::memory_order_relaxed);
+        }
+    }
+
+    // Any thread - linear levels, overs counted since the last resetOvers()
+    struct Reading
+    {
+        float peak = 0.0f;
+        float hold = 0.0f;
+        float rms = 0.0f;
+        int overs = 0;
+    };
+
+    Reading getReading(int channel) const
+    {
+        const auto& published = channels[(size_t) juce::jlimit(0, kMaxChannels - 1, channel)].published;
+        return { published.peak.load(std::memory_order_relaxed),
+                 published.hold.load(std::memory_order_relaxed),
+                 published.rms.load(std::memory_order_relaxed),
+                 published.overs.load(std::memory_order_relaxed) };
+    }
+
+    void resetOvers()
+    {
+        for (auto& channel : channels)
+            channel.published.overs.store(0, std::memory_order_relaxed);
+    }
+
+    // One pass over a channel: peak, sum of squares and samples >= 0 dBFS
+    struct BlockLevels
+    {
+        float peak = 0.0f;
+        float sumSquares = 0.0f;
+        int overs = 0;
+    };
+
+    static BlockLevels measure(const float* samples, int numSamples)
+    {
+        BlockLevels result;
+        float overs = 0.0f;
+        int i = 0;
+
+        const auto accumulate = [&](float x)
+        {
+            const float magnitude = std::abs(x);
+            result.peak = juce::jmax(result.peak, magnitude);
+            result.sumSquares += x * x;
+            overs += magnitude >= 1.0f ? 1.0f : 0.0f;
+        };
+
+#if JUCE_USE_SIMD
+        using Vec = juce::dsp::SIMDRegister<float>;
+
+        // Scalar up to the first aligned sample, then whole registers: the
+        // compare mask ANDed with 1.0f counts overs without leaving the lanes
+        for (; i < numSamples && !Vec::isSIMDAligned(samples + i); ++i)
+            accumulate(samples[i]);
+
+        if (i + (int) Vec::size() <= numSamples)
+        {
+            const auto one = Vec::expand(1.0f);
+            auto peak = Vec::expand(0.0f);
+            auto sumSquares = Vec::expand(0.0f);
+            auto overCount = Vec::expand(0.0f);
+
+            for (; i + (int) Vec::size() <= numSamples; i += (int) Vec::size())
+            {
+                const auto x = Vec::fromRawArray(samples + i);
+                const auto magnitude = Vec::abs(x);
+
+                peak = Vec::max(peak, magnitude);
+                sumSquares += x * x;
+                overCount += one & Vec::greaterThanOrEqual(magnitude, one);
+            }
+
+            for (size_t lane = 0; lane < Vec::size(); ++lane)
+                result.peak = juce::jmax(result.peak, peak.get(lane));
+
+            result.sumSquares += sumSquares.sum();
+            overs += overCount.sum();
+        }
+#endif
+
+        for (; i < numSamples; ++i)
+            accumulate(samples[i]);
+
+        result.overs = (int) overs;
+        return result;
+    }
+
+private:
+    static constexpr float kFallDbPerSecond = 24.0f;
+    static constexpr double kHoldSeconds = 1.0;
+    static constexpr double kRmsSeconds = 0.3;
+
+    struct Channel
+    {
+        // Audio thread state
+        float peak = 0.0f;
+        float hold = 0.0f;
+        float meanSquare = 0.0f;
+        double holdRemaining = 0.0;
+
+        struct
+        {
+            std::atomic<float> peak { 0.0f };
+            std::atomic<float> hold { 0.0f };
+            std::atomic<float> rms { 0.0f };
+            std::atomic<int> overs { 0 };
+        } published;
+    };
+
+    double sampleRate = 44100.0;
+    std::array<Channel, kMaxChannels> channels;
+};
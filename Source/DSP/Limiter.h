@@ -1,5 +1,6 @@
 #pragma once
 #include <juce_dsp/juce_dsp.h>
+#include "StereoLink.h"
 
 class Limiter
 {
@@ -9,22 +10,42 @@ public:
     void prepare(const juce::dsp::ProcessSpec& spec)
     {
         sampleRate = spec.sampleRate;
-        envelope = 0.0f;
-        gainReduction = 0.0f;
+        envelopes.fill(0.0f);
+        channelGainReduction.fill(0.0f);
     }
 
     void reset()
     {
-        envelope = 0.0f;
-        gainReduction = 0.0f;
+        envelopes.fill(0.0f);
+        channelGainReduction.fill(0.0f);
     }
 
+    // True until the first non-silent block after prepare() or reset()
+    bool isIdle() const { return envelopes[0] <= 0.0f && envelopes[1] <= 0.0f; }
+
     void setCeiling(float dB) { ceilingDb = dB; }
     void setRelease(float ms) { releaseMs = ms; }
 
-    float getGainReduction() const { return gainReduction; }
+    // 100%: both channels limited by the louder one; less limits each channel on its own
+    void setStereoLink(float percent) { link = juce::jlimit(0.0f, 1.0f, percent * 0.01f); }
+
+    // Deepest gain reduction over the last block (dB), of either channel
+    float getGainReduction() const { return juce::jmin(channelGainReduction[0], channelGainReduction[1]); }
+
+    // Per channel of the last block (a mono block reports its channel on both)
+    float getGainReduction(size_t channel) const { return channelGainReduction[channel]; }
 
     void process(juce::dsp::ProcessContextReplacing<float>& context)
+    {
+        // Only a stereo pair has channels to unlink
+        if (link >= 1.0f || context.getOutputBlock().getNumChannels() != StereoLink::kMaxChannels)
+            processLinked(context);
+        else
+            processPerChannel(context);
+    }
+
+private:
+    void processLinked(juce::dsp::ProcessContextReplacing<float>& context)
     {
         auto& block = context.getOutputBlock();
         const auto numChannels = block.getNumChannels();
@@ -35,6 +56,7 @@ public:
         float attackCoef = std::exp(-1.0f / (static_cast<float>(sampleRate) * 0.001f)); // 1ms attack
         float releaseCoef = std::exp(-1.0f / (static_cast<float>(sampleRate) * releaseMs * 0.001f));
 
+        float envelope = juce::jmax(envelopes[0], envelopes[1]);
         float maxGR = 0.0f;
 
         for (size_t sample = 0; sample < numSamples; ++sample)
@@ -74,14 +96,68 @@ public:
             if (gr > maxGR) maxGR = gr;
         }
 
-        gainReduction = juce::Decibels::gainToDecibels(1.0f - maxGR + 0.0001f);
+        envelopes.fill(envelope);
+        channelGainReduction.fill(juce::Decibels::gainToDecibels(1.0f - maxGR + 0.0001f));
+    }
+
+    // Both envelopes in one Lanes register, gain and clip per channel
+    void processPerChannel(juce::dsp::ProcessContextReplacing<float>& context)
+    {
+        using Lanes = StereoLink::Lanes<float>;
+
+        auto& block = context.getOutputBlock();
+        const auto numSamples = block.getNumSamples();
+        jassert(block.getNumChannels() == StereoLink::kMaxChannels);
+
+        const float ceiling = juce::Decibels::decibelsToGain(ceilingDb);
+        const auto attack = Lanes::expand(std::exp(-1.0f / (static_cast<float>(sampleRate) * 0.001f)));
+        const auto release = Lanes::expand(std::exp(-1.0f / (static_cast<float>(sampleRate) * releaseMs * 0.001f)));
+
+        Lanes envelope;
+        for (size_t ch = 0; ch < StereoLink::kMaxChannels; ++ch)
+            envelope.set(ch, envelopes[ch]);
+
+        std::array<float, StereoLink::kMaxChannels> maxGR {};
+
+        for (size_t sample = 0; sample < numSamples; ++sample)
+        {
+            std::array<float, StereoLink::kMaxChannels> levels;
+            for (size_t ch = 0; ch < StereoLink::kMaxChannels; ++ch)
+                levels[ch] = std::abs(block.getChannelPointer(ch)[sample]);
+
+            const float loudest = juce::jmax(levels[0], levels[1]);
+
+            Lanes input;
+            for (size_t ch = 0; ch < StereoLink::kMaxChannels; ++ch)
+                input.set(ch, StereoLink::blend(levels[ch], loudest, link));
+
+            envelope.follow(input, attack, release);
+
+            for (size_t ch = 0; ch < StereoLink::kMaxChannels; ++ch)
+            {
+                const float level = envelope.get(ch);
+                const float gain = level > ceiling ? ceiling / level : 1.0f;
+
+                float& sampleValue = block.getChannelPointer(ch)[sample];
+                sampleValue = juce::jlimit(-ceiling, ceiling, sampleValue * gain);
+
+                maxGR[ch] = juce::jmax(maxGR[ch], 1.0f - gain);
+            }
+        }
+
+        for (size_t ch = 0; ch < StereoLink::kMaxChannels; ++ch)
+        {
+            envelopes[ch] = envelope.get(ch);
+            channelGainReduction[ch] = juce::Decibels::gainToDecibels(1.0f - maxGR[ch] + 0.0001f);
+        }
     }
 
-private:
     double sampleRate = 44100.0;
     float ceilingDb = -0.3f;
     float releaseMs = 100.0f;
+    float link = 1.0f;
 
-    float envelope = 0.0f;
-    float gainReduction = 0.0f;
+    // Per channel (equal while linked)
+    std::array<float, StereoLink::kMaxChannels> envelopes {};
+    std::array<float, StereoLink::kMaxChannels> channelGainReduction {};
 };
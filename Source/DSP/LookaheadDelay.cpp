@@ -0,0 +1,2 @@
+#include "LookaheadDelay.h"
+// Implementation in header (inline class)
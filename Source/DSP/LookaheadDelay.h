@@ -0,0 +1,251 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include "MidSide.h"
+#include <array>
+
+/**
+ * Lookahead delay for the dynamics stages.
+ *
+ * Gate and Compressor detect on the undelayed signal and apply their gain to
+ * a delayed copy, so they react before a transient instead of after it. Both
+ * stages' delays live in one ring buffer allocated in prepare() for the
+ * longest lookahead: one power-of-two lane per stage and channel, each with
+ * its own write position. A stage gets a Line (its set of lanes) and calls
+ * exchange() once per channel per sample; a Line with a zero delay is a
+ * straight pass-through.
+ *
+ * A delay change crossfades from the old tap to the new one over
+ * kFadeSamples instead of jumping, which would click. A change that arrives
+ * mid-fade waits for that fade to finish, so a dragged lookahead moves
+ * through a chain of complete fades.
+ *
+ * The two lanes of a line always hold L and R, or mid and side, whichever
+ * channel a mid- or side-only stage processes: setLayout() re-matrixes the
+ * stored history when the stage's matrix changes, so no channel ever reads
+ * back another signal's past.
+ *
+ * The latency of the strip is the sum of both delays. A stage that is
+ * switched off (or runs on one channel of a mid/side pair) still pushes the
+ * rest of the signal through its lanes with delay(), so the latency never
+ * depends on the enable switches.
+ *
+ * A third line carries the input stage's oversampling latency (offline
+ * quality profile) for the bypass path only: the processed path already has
+ * it, so that line is just kept fed with push().
+ */
+class LookaheadDelay
+{
+public:
+    enum Tap { gate = 0, comp, input, numTaps };
+
+    static constexpr float kMaxLookaheadMs = 10.0f;
+    static constexpr int kMaxChannels = 2;
+    static constexpr int kFadeSamples = 256;
+
+    class Line
+    {
+    public:
+        // Writes x into the channel's lane and returns the sample written
+        // getDelay() calls ago (crossfaded while the delay moves)
+        float exchange(size_t channel, float x)
+        {
+            auto& lane = lanes[(channel + laneOffset) % kMaxChannels];
+            lane.data[lane.write] = x;
+
+            // Latched: a new target only starts once the running fade is done
+            if (lane.fadeRemaining == 0 && lane.tap != delaySamples)
+            {
+                lane.fadeFrom = lane.tap;
+                lane.tap = delaySamples;
+                lane.fadeRemaining = kFadeSamples;
+            }
+
+            float delayed = lane.data[(lane.write - lane.tap) & mask];
+
+            if (lane.fadeRemaining > 0)
+            {
+                const float previous = lane.data[(lane.write - lane.fadeFrom) & mask];
+                const float toNew = 1.0f - (float) lane.fadeRemaining * (1.0f / (float) kFadeSamples);
+                delayed = previous + toNew * (delayed - previous);
+                --lane.fadeRemaining;
+            }
+
+            lane.write = (lane.write + 1) & mask;
+            return delayed;
+        }
+
+        // Pure delay of a block through lanes firstLane, firstLane + 1, ...
+        // (also keeps the lanes current while the delay is zero)
+        void delay(juce::dsp::AudioBlock<float> block, size_t firstLane = 0)
+        {
+            jassert(firstLane + block.getNumChannels() <= lanes.size());
+
+            for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+            {
+                float* x = block.getChannelPointer(ch);
+                for (size_t i = 0; i < block.getNumSamples(); ++i)
+                    x[i] = exchange(firstLane + ch, x[i]);
+            }
+        }
+
+        // Writes a block without reading anything back
+        void push(juce::dsp::AudioBlock<float> block)
+        {
+            jassert(block.getNumChannels() <= lanes.size());
+
+            for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+            {
+                const float* x = block.getChannelPointer(ch);
+                auto& lane = lanes[ch];
+                lane.tap = delaySamples;    // Nothing is read back to fade
+                lane.fadeRemaining = 0;
+
+                for (size_t i = 0; i < block.getNumSamples(); ++i)
+                {
+                    lane.data[lane.write] = x[i];
+                    lane.write = (lane.write + 1) & mask;
+                }
+            }
+        }
+
+        int getDelay() const { return delaySamples; }
+
+        // Matrix of the signal about to go through the line, and the lane
+        // channel 0 of the next blocks maps to (1: a side-only stage's single
+        // channel). Re-matrixes the stored history on a change. Both lanes
+        // advance together for a stereo block, so their histories line up.
+        void setLayout(bool midSide, size_t firstLane = 0)
+        {
+            laneOffset = firstLane;
+
+            if (midSide == holdsMidSide)
+                return;
+
+            auto pointers = channelPointers();
+            juce::dsp::AudioBlock<float> history(pointers.data(), kMaxChannels, (size_t) mask + 1);
+            if (midSide)
+                MidSide::encode(history);
+            else
+                MidSide::decode(history);
+
+            holdsMidSide = midSide;
+        }
+
+    private:
+        friend class LookaheadDelay;
+
+        struct Lane
+        {
+            float* data = nullptr;
+            int write = 0;
+            int tap = 0;            // Delay read now (fading to, while fading)
+            int fadeFrom = 0;
+            int fadeRemaining = 0;
+        };
+
+        // New target; each lane fades to it from the tap it is playing
+        void setDelay(int samples) { delaySamples = samples; }
+
+        std::array<float*, kMaxChannels> channelPointers()
+        {
+            std::array<float*, kMaxChannels> pointers;
+            for (size_t ch = 0; ch < kMaxChannels; ++ch)
+                pointers[ch] = lanes[ch].data;
+            return pointers;
+        }
+
+        std::array<Lane, kMaxChannels> lanes {};
+        int mask = 0;
+        int delaySamples = 0;
+        size_t laneOffset = 0;
+        bool holdsMidSide = false;
+    };
+
+    LookaheadDelay() = default;
+
+    // Upper bound of getLatencySamples() at a sample rate: every line at its longest
+    static int getMaxLatencySamples(double sampleRate)
+    {
+        return numTaps * (getLaneLength(sampleRate) - 1);
+    }
+
+    void prepare(const juce::dsp::ProcessSpec& spec)
+    {
+        sampleRate = spec.sampleRate;
+
+        const int maxDelay = msToSamples(kMaxLookaheadMs);
+        const int laneLength = getLaneLength(sampleRate);
+        storage.setSize(numTaps * kMaxChannels, laneLength);
+
+        for (int tap = 0; tap < numTaps; ++tap)
+        {
+            auto& line = lines[(size_t) tap];
+            line.mask = laneLength - 1;
+            line.delaySamples = juce::jmin(line.delaySamples, maxDelay);
+
+            for (int ch = 0; ch < kMaxChannels; ++ch)
+                line.lanes[(size_t) ch].data = storage.getWritePointer(tap * kMaxChannels + ch);
+        }
+
+        reset();
+    }
+
+    void reset()
+    {
+        storage.clear();
+
+        for (auto& line : lines)
+        {
+            line.laneOffset = 0;
+            line.holdsMidSide = false;
+
+            for (auto& lane : line.lanes)
+            {
+                lane.write = 0;
+                lane.tap = line.delaySamples;
+                lane.fadeRemaining = 0;
+            }
+        }
+    }
+
+    void setLookahead(Tap tap, float ms)
+    {
+        auto& line = lines[(size_t) tap];
+        line.setDelay(juce::jlimit(0, line.mask, msToSamples(ms)));
+    }
+
+    void setDelaySamples(Tap tap, int samples)
+    {
+        auto& line = lines[(size_t) tap];
+        jassert(samples <= line.mask);
+        line.setDelay(juce::jlimit(0, line.mask, samples));
+    }
+
+    Line& getLine(Tap tap) { return lines[(size_t) tap]; }
+
+    // Sum of every line - the latency to report to the host
+    int getLatencySamples() const
+    {
+        int total = 0;
+        for (const auto& line : lines)
+            total += line.delaySamples;
+        return total;
+    }
+
+private:
+    static int msToSamples(double rate, float ms)
+    {
+        return juce::roundToInt(rate * (double) juce::jmax(0.0f, ms) * 0.001);
+    }
+
+    int msToSamples(float ms) const { return msToSamples(sampleRate, ms); }
+
+    static int getLaneLength(double rate)
+    {
+        return juce::nextPowerOfTwo(msToSamples(rate, kMaxLookaheadMs) + 1);
+    }
+
+    double sampleRate = 44100.0;
+    juce::AudioBuffer<float> storage;
+    std::array<Line, numTaps> lines;
+};
@@ -0,0 +1,2 @@
+#include "LoudnessMatcher.h"
+// Implementation in header (inline class)
@@ -0,0 +1,128 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include "KWeighting.h"
+
+/**
+ * Auto-gain: compares the K-weighted loudness of the strip's input with the
+ * chain output (before OutputStage) over a sliding 3 s window and reports
+ * the gain that brings the output back to the input loudness. OutputStage
+ * applies it in its gain multiply, so bypass comparisons are level-matched.
+ */
+class LoudnessMatcher
+{
+public:
+    LoudnessMatcher() = default;
+
+    void prepare(const juce::dsp::ProcessSpec& spec)
+    {
+        subBlockLength = juce::jmax(1, juce::roundToInt(spec.sampleRate * 0.1));
+
+        for (auto* side : { &input, &output })
+            side->filters.fill(KWeighting::design(spec.sampleRate));
+
+        reset();
+    }
+
+    void reset()
+    {
+        for (auto* side : { &input, &output })
+        {
+            for (auto& filter : side->filters)
+                filter.reset();
+
+            side->square = 0.0;
+            side->window.fill(0.0);
+            side->windowSum = 0.0;
+        }
+
+        subBlockPosition = 0;
+        windowIndex = 0;
+        compensation = 1.0f;
+    }
+
+    // Both blocks must describe the same samples: the raw input and the chain
+    // result before OutputStage
+    void measureInput(const juce::dsp::AudioBlock<float>& block) { accumulate(input, block, 1.0); }
+
+    // A mid/side block carries half the power of the L/R signal it encodes
+    // (M^2 + S^2 = (L^2 + R^2) / 2) and K-weighting is linear, so it can be
+    // measured as-is and scaled
+    void measureOutput(const juce::dsp::AudioBlock<float>& block, bool midSide = false)
+    {
+        accumulate(output, block, midSide ? 2.0 : 1.0);
+
+        subBlockPosition += (int) block.getNumSamples();
+        while (subBlockPosition >= subBlockLength)
+        {
+            subBlockPosition -= subBlockLength;
+            finishSubBlock();
+        }
+    }
+
+    float getCompensation() const { return compensation; }
+
+private:
+    static constexpr int kMaxChannels = 2;
+    static constexpr int kWindowBlocks = 30;          // 3 s of 100 ms sub-blocks
+    static constexpr double kSilencePower = 1.0e-7;   // ~ -70 LUFS
+    static constexpr float kMaxCompensationDb = 24.0f;
+
+    struct Side
+    {
+        std::array<KWeighting::Filter, kMaxChannels> filters;
+        double square = 0.0;
+        std::array<double, kWindowBlocks> window {};
+        double windowSum = 0.0;
+    };
+
+    void accumulate(Side& side, const juce::dsp::AudioBlock<float>& block, double powerScale)
+    {
+        double square = 0.0;
+
+        const auto numChannels = juce::jmin((size_t) kMaxChannels, block.getNumChannels());
+        const auto numSamples = block.getNumSamples();
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+        {
+            auto& filter = side.filters[ch];
+            const float* data = block.getChannelPointer(ch);
+
+            for (size_t sample = 0; sample < numSamples; ++sample)
+            {
+                const double weighted = filter.process((double) data[sample]);
+                square += weighted * weighted;
+            }
+        }
+
+        side.square += square * powerScale;
+    }
+
+    void finishSubBlock()
+    {
+        for (auto* side : { &input, &output })
+        {
+            side->windowSum += side->square - side->window[(size_t) windowIndex];
+            side->window[(size_t) windowIndex] = side->square;
+            side->square = 0.0;
+        }
+
+        windowIndex = (windowIndex + 1) % kWindowBlocks;
+
+        const double window = (double) subBlockLength * kWindowBlocks;
+        const double inputPower = input.windowSum / window;
+        const double outputPower = output.windowSum / window;
+
+        // Hold the last value through silence so the gain doesn't pump on pauses
+        if (inputPower < kSilencePower || outputPower < kSilencePower)
+            return;
+
+        const float maxGain = juce::Decibels::decibelsToGain(kMaxCompensationDb);
+        compensation = juce::jlimit(1.0f / maxGain, maxGain, (float) std::sqrt(inputPower / outputPower));
+    }
+
+    Side input, output;
+    int subBlockLength = 4410;
+    int subBlockPosition = 0;
+    int windowIndex = 0;
+    float compensation = 1.0f;
+};
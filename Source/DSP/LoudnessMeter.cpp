@@ -0,0 +1,316 @@
+#include "LoudnessMeter.h"
+
+namespace
+{
+    constexpr double kAbsoluteGateLufs = -70.0;
+    constexpr double kIntegratedRelativeGate = -10.0;
+    constexpr double kRangeRelativeGate = -20.0;
+    constexpr double kHistogramStep = 0.1;
+
+    // ITU-R BS.1770-4 Annex 2: 48-tap, 4-phase interpolation filter
+    constexpr float kTruePeakCoefficients[4][12] = {
+        {  0.0017089843750f,  0.0109863281250f, -0.0196533203125f,  0.0332031250000f,
+          -0.0594482421875f,  0.1373291015625f,  0.9721679687500f, -0.1022949218750f,
+           0.0476074218750f, -0.0266113281250f,  0.0148925781250f, -0.0083007812500f },
+        { -0.0291748046875f,  0.0292968750000f, -0.0517578125000f,  0.0891113281250f,
+          -0.1665039062500f,  0.4650878906250f,  0.7797851562500f, -0.2003173828125f,
+           0.1015625000000f, -0.0582275390625f,  0.0330810546875f, -0.0189208984375f },
+        { -0.0189208984375f,  0.0330810546875f, -0.0582275390625f,  0.1015625000000f,
+          -0.2003173828125f,  0.7797851562500f,  0.4650878906250f, -0.1665039062500f,
+           0.0891113281250f, -0.0517578125000f,  0.0292968750000f, -0.0291748046875f },
+        { -0.0083007812500f,  0.0148925781250f, -0.0266113281250f,  0.0476074218750f,
+          -0.1022949218750f,  0.9721679687500f,  0.1373291015625f, -0.0594482421875f,
+           0.0332031250000f, -0.0196533203125f,  0.0109863281250f,  0.0017089843750f }
+    };
+}
+
+LoudnessMeter::LoudnessMeter()
+    : juce::Thread("Loudness Meter")
+{
+}
+
+LoudnessMeter::~LoudnessMeter()
+{
+    release();
+}
+
+void LoudnessMeter::prepare(double newSampleRate, int numChannels)
+{
+    release();
+
+    sampleRate = newSampleRate;
+    numChannelsInUse = juce::jlimit(1, kMaxChannels, numChannels);
+    subBlockLength = juce::jmax(1, juce::roundToInt(sampleRate * 0.1));
+
+    // ~0.5 s of headroom - the worker drains every 20 ms
+    const int capacity = juce::nextPowerOfTwo(juce::roundToInt(sampleRate * 0.5));
+    fifo.setTotalSize(capacity);
+    fifoBuffer.setSize(kMaxChannels, capacity);
+    fifo.reset();
+
+    kWeighting.fill(KWeighting::design(sampleRate));
+
+    resetAnalysis();
+    startThread(juce::Thread::Priority::low);
+}
+
+void LoudnessMeter::release()
+{
+    stopThread(1000);
+}
+
+void LoudnessMeter::push(const juce::AudioBuffer<float>& buffer, int numSamples)
+{
+    if (!isThreadRunning())
+        return;
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+    const int channels = juce::jmin(numChannelsInUse, buffer.getNumChannels());
+    for (int ch = 0; ch < channels; ++ch)
+    {
+        if (size1 > 0) fifoBuffer.copyFrom(ch, start1, buffer, ch, 0, size1);
+        if (size2 > 0) fifoBuffer.copyFrom(ch, start2, buffer, ch, size1, size2);
+    }
+
+    fifo.finishedWrite(size1 + size2);
+}
+
+void LoudnessMeter::requestReset()
+{
+    resetRequested.store(true);
+    notify();
+}
+
+void LoudnessMeter::run()
+{
+    while (!threadShouldExit())
+    {
+        if (resetRequested.exchange(false))
+            resetAnalysis();
+
+        drainFifo();
+        wait(20);
+    }
+}
+
+void LoudnessMeter::drainFifo()
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(fifo.getNumReady(), start1, size1, start2, size2);
+
+    for (auto [start, size] : { std::pair { start1, size1 }, std::pair { start2, size2 } })
+    {
+        for (int i = start; i < start + size; ++i)
+        {
+            for (int ch = 0; ch < numChannelsInUse; ++ch)
+                processSample(ch, fifoBuffer.getSample(ch, i));
+
+            truePeakPosition = (truePeakPosition + 1) % kTruePeakTaps;
+
+            if (++subBlockPosition >= subBlockLength)
+                finishSubBlock();
+        }
+    }
+
+    fifo.finishedRead(size1 + size2);
+    truePeakDb.store(juce::Decibels::gainToDecibels(truePeakMax, kSilenceLufs));
+}
+
+void LoudnessMeter::processSample(int channel, float sample)
+{
+    // Loudness
+    const double weighted = kWeighting[(size_t) channel].process((double) sample);
+    channelSquares[(size_t) channel] += weighted * weighted;
+
+    // True-peak: newest sample lands at truePeakPosition, history runs backwards from it
+    auto& history = truePeakHistory[(size_t) channel];
+    history[(size_t) truePeakPosition] = sample;
+
+    for (const auto& phase : kTruePeakCoefficients)
+    {
+        float interpolated = 0.0f;
+        int index = truePeakPosition;
+
+        for (int tap = 0; tap < kTruePeakTaps; ++tap)
+        {
+            interpolated += phase[tap] * history[(size_t) index];
+            index = index == 0 ? kTruePeakTaps - 1 : index - 1;
+        }
+
+        truePeakMax = juce::jmax(truePeakMax, std::abs(interpolated));
+    }
+}
+
+void LoudnessMeter::finishSubBlock()
+{
+    // Channel weights are 1.0 for L/R (BS.1770 Table 3)
+    double power = 0.0;
+    for (int ch = 0; ch < numChannelsInUse; ++ch)
+    {
+        power += channelSquares[(size_t) ch] / (double) subBlockLength;
+        channelSquares[(size_t) ch] = 0.0;
+    }
+
+    subBlockPosition = 0;
+    subBlockPower[(size_t) subBlockIndex] = power;
+    subBlockIndex = (subBlockIndex + 1) % kShortTermBlocks;
+    ++subBlocksSeen;
+
+    auto meanOfLast = [this](int count)
+    {
+        double sum = 0.0;
+        int index = subBlockIndex;
+        for (int i = 0; i < count; ++i)
+        {
+            index = index == 0 ? kShortTermBlocks - 1 : index - 1;
+            sum += subBlockPower[(size_t) index];
+        }
+        return sum / count;
+    };
+
+    // Momentary: 400 ms window every 100 ms = the 75 % overlapped gating blocks
+    if (subBlocksSeen >= kMomentaryBlocks)
+    {
+        const double blockPower = meanOfLast(kMomentaryBlocks);
+        const double lufs = powerToLufs(blockPower);
+        momentaryLufs.store((float) lufs);
+
+        if (lufs > kAbsoluteGateLufs)
+        {
+            const int bin = lufsToBin(lufs);
+            integratedPower[(size_t) bin] += blockPower;
+            ++integratedCount[(size_t) bin];
+            updateIntegrated();
+        }
+    }
+
+    // Short-term: 3 s window, sampled at 10 Hz for the loudness range
+    if (subBlocksSeen >= kShortTermBlocks)
+    {
+        const double lufs = powerToLufs(meanOfLast(kShortTermBlocks));
+        shortTermLufs.store((float) lufs);
+
+        if (lufs > kAbsoluteGateLufs)
+        {
+            ++rangeCount[(size_t) lufsToBin(lufs)];
+            updateLoudnessRange();
+        }
+    }
+}
+
+void LoudnessMeter::updateIntegrated()
+{
+    double power = 0.0;
+    juce::uint64 count = 0;
+    for (int bin = 0; bin < kHistogramBins; ++bin)
+    {
+        power += integratedPower[(size_t) bin];
+        count += integratedCount[(size_t) bin];
+    }
+
+    if (count == 0)
+        return;
+
+    const double relativeGate = powerToLufs(power / (double) count) + kIntegratedRelativeGate;
+    const int firstBin = juce::jlimit(0, kHistogramBins - 1, lufsToBin(relativeGate));
+
+    power = 0.0;
+    count = 0;
+    for (int bin = firstBin; bin < kHistogramBins; ++bin)
+    {
+        power += integratedPower[(size_t) bin];
+        count += integratedCount[(size_t) bin];
+    }
+
+    if (count > 0)
+        integratedLufs.store((float) powerToLufs(power / (double) count));
+}
+
+void LoudnessMeter::updateLoudnessRange()
+{
+    auto binCentre = [](int bin) { return kAbsoluteGateLufs + (bin + 0.5) * kHistogramStep; };
+
+    double power = 0.0;
+    juce::uint64 count = 0;
+    for (int bin = 0; bin < kHistogramBins; ++bin)
+    {
+        const auto binCount = rangeCount[(size_t) bin];
+        power += binCount * std::pow(10.0, (binCentre(bin) + 0.691) / 10.0);
+        count += binCount;
+    }
+
+    if (count == 0)
+        return;
+
+    const double relativeGate = powerToLufs(power / (double) count) + kRangeRelativeGate;
+    const int firstBin = juce::jlimit(0, kHistogramBins - 1, lufsToBin(relativeGate));
+
+    juce::uint64 gatedCount = 0;
+    for (int bin = firstBin; bin < kHistogramBins; ++bin)
+        gatedCount += rangeCount[(size_t) bin];
+
+    if (gatedCount == 0)
+        return;
+
+    const auto lowTarget = (juce::uint64) (0.10 * (double) gatedCount);
+    const auto highTarget = (juce::uint64) (0.95 * (double) gatedCount);
+    double low = binCentre(firstBin), high = low;
+
+    juce::uint64 cumulative = 0;
+    for (int bin = firstBin; bin < kHistogramBins; ++bin)
+    {
+        const auto previous = cumulative;
+        cumulative += rangeCount[(size_t) bin];
+
+        if (previous <= lowTarget && cumulative > lowTarget)
+            low = binCentre(bin);
+        if (previous <= highTarget && cumulative > highTarget)
+        {
+            high = binCentre(bin);
+            break;
+        }
+    }
+
+    loudnessRange.store((float) (high - low));
+}
+
+void LoudnessMeter::resetAnalysis()
+{
+    for (auto& filter : kWeighting)
+        filter.reset();
+
+    channelSquares.fill(0.0);
+    subBlockPower.fill(0.0);
+    subBlockIndex = 0;
+    subBlocksSeen = 0;
+    subBlockPosition = 0;
+
+    integratedPower.fill(0.0);
+    integratedCount.fill(0);
+    rangeCount.fill(0);
+
+    for (auto& history : truePeakHistory)
+        history.fill(0.0f);
+    truePeakPosition = 0;
+    truePeakMax = 0.0f;
+
+    momentaryLufs.store(kSilenceLufs);
+    shortTermLufs.store(kSilenceLufs);
+    integratedLufs.store(kSilenceLufs);
+    loudnessRange.store(0.0f);
+    truePeakDb.store(kSilenceLufs);
+}
+
+double LoudnessMeter::powerToLufs(double power)
+{
+    return power > 0.0 ? juce::jmax((double) kSilenceLufs, -0.691 + 10.0 * std::log10(power))
+                       : (double) kSilenceLufs;
+}
+
+int LoudnessMeter::lufsToBin(double lufs)
+{
+    return juce::jlimit(0, kHistogramBins - 1,
+                        (int) std::floor((lufs - kAbsoluteGateLufs) / kHistogramStep));
+}
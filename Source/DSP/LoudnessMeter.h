@@ -0,0 +1,99 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include "KWeighting.h"
+
+/**
+ * EBU R128 / ITU-R BS.1770 loudness and true-peak meter.
+ *
+ * The audio thread only copies samples into a lock-free FIFO (push). A worker
+ * thread applies K-weighting, accumulates 100 ms sub-blocks and derives:
+ *   - momentary (400 ms) and short-term (3 s) loudness
+ *   - gated integrated loudness (-70 LUFS absolute, -10 LU relative)
+ *   - loudness range (short-term, -20 LU relative, 10th-95th percentile)
+ *   - 4x oversampled true-peak (BS.1770 Annex 2 interpolator), held until reset
+ * Results are published as atomics for the UI timer.
+ */
+class LoudnessMeter : private juce::Thread
+{
+public:
+    static constexpr float kSilenceLufs = -100.0f;
+
+    LoudnessMeter();
+    ~LoudnessMeter() override;
+
+    // Message thread - (re)starts the worker
+    void prepare(double sampleRate, int numChannels);
+    void release();
+
+    // Audio thread - never blocks; drops samples if the worker falls behind
+    void push(const juce::AudioBuffer<float>& buffer, int numSamples);
+
+    // Any thread - cleared by the worker before it reads more audio
+    void requestReset();
+
+    float getMomentary() const { return momentaryLufs.load(); }
+    float getShortTerm() const { return shortTermLufs.load(); }
+    float getIntegrated() const { return integratedLufs.load(); }
+    float getLoudnessRange() const { return loudnessRange.load(); }
+    float getTruePeak() const { return truePeakDb.load(); }
+
+private:
+    static constexpr int kMaxChannels = 2;
+    static constexpr int kTruePeakTaps = 12;       // per phase, 48 taps total
+    static constexpr int kMomentaryBlocks = 4;     // 400 ms of 100 ms sub-blocks
+    static constexpr int kShortTermBlocks = 30;    // 3 s
+    static constexpr int kHistogramBins = 1000;    // -70 ... +30 LUFS in 0.1 LU steps
+
+    void run() override;
+    void drainFifo();
+    void processSample(int channel, float sample);
+    void finishSubBlock();
+    void resetAnalysis();
+    void updateIntegrated();
+    void updateLoudnessRange();
+
+    static double powerToLufs(double power);
+    static int lufsToBin(double lufs);
+
+    // ==============================================================================
+    // FIFO (audio thread -> worker)
+    // ==============================================================================
+    juce::AbstractFifo fifo { 1 };
+    juce::AudioBuffer<float> fifoBuffer;
+    int numChannelsInUse = 2;
+
+    // ==============================================================================
+    // Worker state
+    // ==============================================================================
+    double sampleRate = 48000.0;
+    int subBlockLength = 4800;
+    int subBlockPosition = 0;
+
+    std::array<KWeighting::Filter, kMaxChannels> kWeighting;
+    std::array<double, kMaxChannels> channelSquares {};
+
+    std::array<double, kShortTermBlocks> subBlockPower {};
+    int subBlockIndex = 0;
+    int subBlocksSeen = 0;
+
+    // Gating histograms: power sum + count per bin for integrated, count for LRA
+    std::array<double, kHistogramBins> integratedPower {};
+    std::array<juce::uint32, kHistogramBins> integratedCount {};
+    std::array<juce::uint32, kHistogramBins> rangeCount {};
+
+    std::array<std::array<float, kTruePeakTaps>, kMaxChannels> truePeakHistory {};
+    int truePeakPosition = 0;
+    float truePeakMax = 0.0f;
+
+    // ==============================================================================
+    // Published results
+    // ==============================================================================
+    std::atomic<bool> resetRequested { false };
+    std::atomic<float> momentaryLufs { kSilenceLufs };
+    std::atomic<float> shortTermLufs { kSilenceLufs };
+    std::atomic<float> integratedLufs { kSilenceLufs };
+    std::atomic<float> loudnessRange { 0.0f };
+    std::atomic<float> truePeakDb { kSilenceLufs };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoudnessMeter)
+};
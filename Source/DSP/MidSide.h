@@ -0,0 +1,57 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+
+/**
+ * Mid/side matrix for the processing chain.
+ * encode: M = (L + R) / 2, S = (L - R) / 2 - decode is the exact inverse.
+ * The chain normally never calls these: InputStage encodes as part of its
+ * gain multiply and OutputStage decodes as part of its width matrix. They
+ * only run between two sections that disagree about the matrix.
+ */
+namespace MidSide
+{
+    // Channel mode of a section; the index of the eqMode/gateMode/compMode/limiterMode choices
+    enum class Mode
+    {
+        stereo = 0, // L/R
+        mid,        // Mid only, side passes through
+        side,       // Side only, mid passes through
+        midSide     // Mid and side as two independent channels
+    };
+
+    inline const juce::StringArray& getModeNames()
+    {
+        static const juce::StringArray names { "L/R", "Mid", "Side", "M/S" };
+        return names;
+    }
+
+    inline bool needsMidSide(Mode mode) { return mode != Mode::stereo; }
+
+    inline void encode(juce::dsp::AudioBlock<float>& block)
+    {
+        float* left = block.getChannelPointer(0);
+        float* right = block.getChannelPointer(1);
+
+        for (size_t sample = 0; sample < block.getNumSamples(); ++sample)
+        {
+            const float l = left[sample];
+            const float r = right[sample];
+            left[sample] = (l + r) * 0.5f;
+            right[sample] = (l - r) * 0.5f;
+        }
+    }
+
+    inline void decode(juce::dsp::AudioBlock<float>& block)
+    {
+        float* mid = block.getChannelPointer(0);
+        float* side = block.getChannelPointer(1);
+
+        for (size_t sample = 0; sample < block.getNumSamples(); ++sample)
+        {
+            const float m = mid[sample];
+            const float s = side[sample];
+            mid[sample] = m + s;
+            side[sample] = m - s;
+        }
+    }
+}
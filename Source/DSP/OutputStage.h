@@ -1,5 +1,6 @@
 #pragma once
 #include <juce_dsp/juce_dsp.h>
+#include "GainRamp.h"
 
 class OutputStage
 {
@@ -9,16 +10,22 @@ public:
     void prepare(const juce::dsp::ProcessSpec& spec)
     {
         sampleRate = spec.sampleRate;
-        smoothedGain.reset(spec.sampleRate, 0.02);
+        maxBlockSize = (size_t) spec.maximumBlockSize;
+        smoothedGain.prepare(spec.sampleRate, 0.02, (int) spec.maximumBlockSize);
         smoothedGain.setCurrentAndTargetValue(1.0f);
-        smoothedWidth.reset(spec.sampleRate, 0.02);
+        smoothedWidth.prepare(spec.sampleRate, 0.02, (int) spec.maximumBlockSize);
         smoothedWidth.setCurrentAndTargetValue(1.0f);
+        // Auto-gain moves slowly so it never reads as pumping
+        smoothedCompensation.prepare(spec.sampleRate, 1.0, (int) spec.maximumBlockSize);
+        smoothedCompensation.setCurrentAndTargetValue(1.0f);
+        gainRamp.assign((size_t) spec.maximumBlockSize, 1.0f);
     }
 
     void reset()
     {
         smoothedGain.setCurrentAndTargetValue(smoothedGain.getTargetValue());
         smoothedWidth.setCurrentAndTargetValue(smoothedWidth.getTargetValue());
+        smoothedCompensation.setCurrentAndTargetValue(smoothedCompensation.getTargetValue());
     }
 
     void setGain(float dB)
@@ -26,61 +33,214 @@ public:
         smoothedGain.setTargetValue(juce::Decibels::decibelsToGain(dB));
     }
 
+    // Linear loudness-matching gain from LoudnessMatcher (1.0 when auto-gain is off)
+    void setCompensation(float gain)
+    {
+        smoothedCompensation.setTargetValue(gain);
+    }
+
     void setWidth(float percent)
     {
         // 0% = mono, 100% = normal, 200% = extra wide
         smoothedWidth.setTargetValue(percent / 100.0f);
     }
 
+    // Gain InputStage left for this stage (see InputStage::setDeferredGains):
+    // ramp[i] * value per sample, or value alone when ramp is nullptr. Set
+    // for every slice; it rides in the same matrix multiply as the rest.
+    void setCarriedGain(const float* ramp, float value)
+    {
+        carriedRamp = ramp;
+        carriedValue = value;
+    }
+
+    // The chain hands over a mid/side block (stereo only); decoding is folded
+    // into the width matrix below
+    void setMidSideInput(bool enabled) { midSideInput = enabled; }
+
     void process(juce::dsp::ProcessContextReplacing<float>& context)
     {
         auto& block = context.getOutputBlock();
-        const auto numChannels = block.getNumChannels();
         const auto numSamples = block.getNumSamples();
 
+        // Ramps are produced at most one prepared block at a time
+        jassert(maxBlockSize > 0);
+        jassert(numSamples <= maxBlockSize || carriedRamp == nullptr);
+        for (size_t start = 0; start < numSamples; start += maxBlockSize)
+            processSlice(block.getSubBlock(start, juce::jmin(maxBlockSize, numSamples - start)));
+    }
+
+private:
+    void processSlice(juce::dsp::AudioBlock<float> block)
+    {
+        const auto numChannels = block.getNumChannels();
+        const int numSamples = (int) block.getNumSamples();
+
+        // Gain, compensation and the gain carried from InputStage collapse into
+        // one ramp, or one scalar once all of them have settled
+        const float* gain = nullptr;
+        float gainValue = carriedValue;
+
+        if (smoothedGain.isSmoothing() || smoothedCompensation.isSmoothing() || carriedRamp != nullptr)
+        {
+            juce::FloatVectorOperations::multiply(gainRamp.data(),
+                                                  smoothedGain.next(numSamples),
+                                                  smoothedCompensation.next(numSamples),
+                                                  numSamples);
+            if (carriedRamp != nullptr)
+                juce::FloatVectorOperations::multiply(gainRamp.data(), carriedRamp, numSamples);
+            if (!juce::exactlyEqual(carriedValue, 1.0f))
+                juce::FloatVectorOperations::multiply(gainRamp.data(), carriedValue, numSamples);
+
+            gain = gainRamp.data();
+        }
+        else
+        {
+            gainValue *= smoothedGain.getCurrentValue() * smoothedCompensation.getCurrentValue();
+        }
+
         if (numChannels < 2)
         {
             // Mono - just apply gain
-            for (size_t sample = 0; sample < numSamples; ++sample)
-            {
-                float gain = smoothedGain.getNextValue();
-                smoothedWidth.getNextValue(); // Keep width smoother in sync
+            smoothedWidth.skip(numSamples); // Keep width smoother in sync
 
-                for (size_t ch = 0; ch < numChannels; ++ch)
-                {
-                    block.getChannelPointer(ch)[sample] *= gain;
-                }
-            }
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                applyGain(block.getChannelPointer(ch), numSamples, gain, gainValue);
             return;
         }
 
-        // Stereo processing with width control
         float* leftChannel = block.getChannelPointer(0);
         float* rightChannel = block.getChannelPointer(1);
 
-        for (size_t sample = 0; sample < numSamples; ++sample)
+        const float* width = smoothedWidth.isSmoothing() ? smoothedWidth.next(numSamples) : nullptr;
+        const float widthValue = smoothedWidth.getCurrentValue();
+
+        // A settled width of 100% or 0% reduces the matrix to a gain (plus the
+        // decode for a mid/side block) or a mono sum - the full width matrix
+        // only runs while width moves or sits anywhere in between. Settled
+        // ramps land exactly on their target, so the comparisons are exact.
+        if (width == nullptr && juce::exactlyEqual(widthValue, 1.0f))
         {
-            float gain = smoothedGain.getNextValue();
-            float width = smoothedWidth.getNextValue();
+            if (midSideInput && gain != nullptr)
+                decode<true>(leftChannel, rightChannel, numSamples, gain, gainValue);
+            else if (midSideInput)
+                decode<false>(leftChannel, rightChannel, numSamples, gain, gainValue);
+            else
+            {
+                applyGain(leftChannel, numSamples, gain, gainValue);
+                applyGain(rightChannel, numSamples, gain, gainValue);
+            }
+        }
+        else if (width == nullptr && juce::exactlyEqual(widthValue, 0.0f))
+        {
+            // Mid to both sides - mid/side input already carries it in the left channel
+            if (!midSideInput)
+            {
+                juce::FloatVectorOperations::add(leftChannel, rightChannel, numSamples);
 
-            float left = leftChannel[sample];
-            float right = rightChannel[sample];
+                if (gain != nullptr)
+                    juce::FloatVectorOperations::multiply(leftChannel, 0.5f, numSamples);
+                else
+                    gainValue *= 0.5f;
+            }
 
-            // Mid-Side processing for width
-            float mid = (left + right) * 0.5f;
-            float side = (left - right) * 0.5f;
+            applyGain(leftChannel, numSamples, gain, gainValue);
+            juce::FloatVectorOperations::copy(rightChannel, leftChannel, numSamples);
+        }
+        else if (midSideInput)
+        {
+            processMatrix<true>(leftChannel, rightChannel, numSamples, gain, gainValue, width, widthValue);
+        }
+        else
+        {
+            processMatrix<false>(leftChannel, rightChannel, numSamples, gain, gainValue, width, widthValue);
+        }
+    }
+
+    // gain is a per-sample ramp, or nullptr to use gainValue
+    static void applyGain(float* channel, int numSamples, const float* gain, float gainValue)
+    {
+        if (gain != nullptr)
+            juce::FloatVectorOperations::multiply(channel, gain, numSamples);
+        else if (!juce::exactlyEqual(gainValue, 1.0f))
+            juce::FloatVectorOperations::multiply(channel, gainValue, numSamples);
+    }
+
+    // Kernels take the ramp-or-scalar choice as template arguments, so each
+    // instantiation is a branch-free loop the compiler can vectorise
+    template <bool RampGain>
+    static void decode(float* leftChannel, float* rightChannel, int numSamples,
+                       const float* gain, float gainValue)
+    {
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            float g;
+            if constexpr (RampGain) g = gain[sample]; else g = gainValue;
+
+            const float mid = leftChannel[sample];
+            const float side = rightChannel[sample];
+
+            leftChannel[sample] = (mid + side) * g;
+            rightChannel[sample] = (mid - side) * g;
+        }
+    }
+
+    // Full width matrix; gain and width are per-sample ramps, or nullptr to use the scalar value
+    template <bool MidSideInput>
+    static void processMatrix(float* leftChannel, float* rightChannel, int numSamples,
+                              const float* gain, float gainValue, const float* width, float widthValue)
+    {
+        if (gain != nullptr && width != nullptr)
+            matrix<MidSideInput, true, true>(leftChannel, rightChannel, numSamples, gain, gainValue, width, widthValue);
+        else if (gain != nullptr)
+            matrix<MidSideInput, true, false>(leftChannel, rightChannel, numSamples, gain, gainValue, width, widthValue);
+        else if (width != nullptr)
+            matrix<MidSideInput, false, true>(leftChannel, rightChannel, numSamples, gain, gainValue, width, widthValue);
+        else
+            matrix<MidSideInput, false, false>(leftChannel, rightChannel, numSamples, gain, gainValue, width, widthValue);
+    }
+
+    template <bool MidSideInput, bool RampGain, bool RampWidth>
+    static void matrix(float* leftChannel, float* rightChannel, int numSamples,
+                       const float* gain, float gainValue, const float* width, float widthValue)
+    {
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            float g, w;
+            if constexpr (RampGain) g = gain[sample]; else g = gainValue;
+            if constexpr (RampWidth) w = width[sample]; else w = widthValue;
+
+            float mid, side;
+
+            if constexpr (MidSideInput)
+            {
+                // Already mid/side from the chain
+                mid = leftChannel[sample];
+                side = rightChannel[sample];
+            }
+            else
+            {
+                // Mid-Side processing for width
+                mid = (leftChannel[sample] + rightChannel[sample]) * 0.5f;
+                side = (leftChannel[sample] - rightChannel[sample]) * 0.5f;
+            }
 
             // Apply width to side signal
-            side *= width;
+            side *= w;
 
             // Convert back to L/R
-            leftChannel[sample] = (mid + side) * gain;
-            rightChannel[sample] = (mid - side) * gain;
+            leftChannel[sample] = (mid + side) * g;
+            rightChannel[sample] = (mid - side) * g;
         }
     }
 
-private:
     double sampleRate = 44100.0;
-    juce::SmoothedValue<float> smoothedGain;
-    juce::SmoothedValue<float> smoothedWidth;
+    size_t maxBlockSize = 0;
+    GainRamp<> smoothedGain;
+    GainRamp<> smoothedWidth;
+    GainRamp<juce::ValueSmoothingTypes::Multiplicative> smoothedCompensation;
+    std::vector<float> gainRamp; // Output gain x compensation x carried gain while any moves
+    const float* carriedRamp = nullptr;
+    float carriedValue = 1.0f;
+    bool midSideInput = false;
 };
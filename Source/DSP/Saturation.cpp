@@ -0,0 +1,2 @@
+#include "Saturation.h"
+// Implementation in header (inline class)
@@ -0,0 +1,270 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+#include <cmath>
+#include "StereoLink.h"
+
+/**
+ * Input drive with first-order antiderivative anti-aliasing (ADAA).
+ *
+ * Instead of f(u[n]), each sample outputs the mean of f over the segment from
+ * u[n-1] to u[n]: (F(u[n]) - F(u[n-1])) / (u[n] - u[n-1]), with F the
+ * antiderivative of f. That attenuates the aliased harmonics of the
+ * waveshaper without oversampling, at the cost of a half-sample delay on the
+ * driven path. When the segment is too short for the division to be well
+ * conditioned the midpoint f((u[n] + u[n-1]) / 2) is used instead.
+ *
+ * Both channels go through one StereoLink::Lanes register a sample at a
+ * time. The curves are polynomials with a clamp, so F and the midpoint are
+ * multiplies, min/max and selects shared by the lanes; only the final
+ * division is per channel, as SIMD registers have none. F is evaluated in
+ * double - the difference quotient cancels most of it. The block arrives
+ * already driven: InputStage folds the drive into its gain ramp.
+ */
+class Saturation
+{
+public:
+    // Index of the inputSaturation choice
+    enum class Curve
+    {
+        off = 0,
+        tape, // tanh-shaped soft clip - odd harmonics
+        tube  // biased soft clip - adds even harmonics
+    };
+
+    static const juce::StringArray& getCurveNames()
+    {
+        static const juce::StringArray names { "Off", "Tape", "Tube" };
+        return names;
+    }
+
+    static constexpr size_t kMaxChannels = 2;
+
+    Saturation() = default;
+
+    void prepare(const juce::dsp::ProcessSpec& spec)
+    {
+        jassert(spec.numChannels <= (juce::uint32) kMaxChannels);
+        numChannels = juce::jmin((size_t) spec.numChannels, kMaxChannels);
+
+        // One-pole DC blocker at ~10 Hz for the asymmetric curve
+        dcCoefficient = 1.0f - (float) (juce::MathConstants<double>::twoPi * 10.0 / spec.sampleRate);
+
+        reset();
+    }
+
+    void reset()
+    {
+        lastDriven = Lanes::expand(0.0);
+        lastIntegral = antiderivative(curve, lastDriven);
+        dcIn.fill(0.0f);
+        dcOut.fill(0.0f);
+    }
+
+    void setCurve(Curve newCurve)
+    {
+        if (newCurve == curve)
+            return;
+
+        // Coming out of bypass the carried state is stale
+        if (curve == Curve::off)
+        {
+            curve = newCurve;
+            reset();
+            return;
+        }
+
+        curve = newCurve;
+
+        // Keep the previous input, re-evaluate its integral under the new curve
+        lastIntegral = antiderivative(curve, lastDriven);
+    }
+
+    Curve getCurve() const { return curve; }
+    bool isActive() const { return curve != Curve::off; }
+
+    // The block must already carry the drive
+    void process(juce::dsp::AudioBlock<float>& block)
+    {
+        // Dispatch once per block so the curve is a constant inside the loop
+        switch (curve)
+        {
+            case Curve::tape: processWith<Curve::tape>(block); break;
+            case Curve::tube: processWith<Curve::tube>(block); break;
+            case Curve::off:  break;
+        }
+    }
+
+private:
+    using Lanes = StereoLink::Lanes<double>;
+
+    static constexpr double kMinDelta = 1.0e-5;
+
+    // A chunk at a time: the channels interleaved into one register per
+    // sample, F and the steps on the registers, then the quotient per channel
+    template <Curve C>
+    void processWith(juce::dsp::AudioBlock<float>& block)
+    {
+        constexpr size_t kChunk = 64;
+        constexpr size_t w = Lanes::width;
+
+        const auto numSamples = block.getNumSamples();
+        const auto numBlockChannels = juce::jmin(block.getNumChannels(), numChannels);
+
+        // Lanes without a channel stay at 0
+        alignas(Lanes::kAlignment) double driven[kChunk * w] {};
+        alignas(Lanes::kAlignment) double rise[kChunk * w];
+        alignas(Lanes::kAlignment) double delta[kChunk * w];
+        alignas(Lanes::kAlignment) double midpoint[kChunk * w] {};
+
+        auto previous = lastDriven;
+        auto previousIntegral = lastIntegral;
+
+        for (size_t start = 0; start < numSamples; start += kChunk)
+        {
+            const auto length = juce::jmin(kChunk, numSamples - start);
+
+            for (size_t ch = 0; ch < numBlockChannels; ++ch)
+            {
+                const float* x = block.getChannelPointer(ch) + start;
+                for (size_t i = 0; i < length; ++i)
+                    driven[i * w + ch] = (double) x[i];
+            }
+
+            for (size_t i = 0; i < length; ++i)
+            {
+                const auto u = Lanes::load(driven + i * w);
+                const auto integral = antiderivative(C, u);
+
+                (integral - previousIntegral).store(rise + i * w);
+                (u - previous).store(delta + i * w);
+
+                previous = u;
+                previousIntegral = integral;
+            }
+
+            // Held or barely moving input (silence, mostly) takes the midpoint
+            for (size_t i = 0; i < length; ++i)
+            {
+                bool flat = false;
+                for (size_t ch = 0; ch < numBlockChannels; ++ch)
+                    flat = flat || !(std::abs(delta[i * w + ch]) > kMinDelta);
+
+                if (flat)
+                {
+                    const auto u = Lanes::load(driven + i * w);
+                    shape(C, u - Lanes::load(delta + i * w) * Lanes::expand(0.5)).store(midpoint + i * w);
+                }
+            }
+
+            for (size_t ch = 0; ch < numBlockChannels; ++ch)
+            {
+                float* x = block.getChannelPointer(ch) + start;
+                for (size_t i = 0; i < length; ++i)
+                {
+                    const double d = delta[i * w + ch];
+                    x[i] = (float) (std::abs(d) > kMinDelta ? rise[i * w + ch] / d : midpoint[i * w + ch]);
+                }
+            }
+        }
+
+        lastDriven = previous;
+        lastIntegral = previousIntegral;
+
+        if constexpr (C == Curve::tube)
+        {
+            for (size_t ch = 0; ch < numBlockChannels; ++ch)
+                removeDc(block.getChannelPointer(ch), numSamples, ch);
+        }
+    }
+
+    // ==============================================================================
+    // Curves - unity slope at 0 so drive 1 leaves quiet signals untouched
+    // ==============================================================================
+    // The tanh stand-in: an odd polynomial up to kKnee, +-1 beyond. It is
+    // within 2e-3 of tanh and meets the clamp with zero first and second
+    // derivatives, so F (its log cosh) is smooth across the knee too.
+    static constexpr double kKnee = 3.5;
+
+    static Lanes magnitude(const Lanes& u) { return Lanes::max(u, Lanes::expand(0.0) - u); }
+
+    static Lanes softClip(const Lanes& u)
+    {
+        const auto a = Lanes::min(magnitude(u), Lanes::expand(kKnee));
+        const auto p = a * Lanes::horner(a * a, Lanes::expand(2.5907055406709572e-08),
+                                         -1.5718078133593366e-06, 4.038350393169113e-05, -0.0005753199158475638,
+                                         0.005024679859173875, -0.028412915919084274, 0.11003287698803853,
+                                         -0.3246370857660776, 1.0);
+
+        return Lanes::selectGreater(Lanes::expand(0.0), u, Lanes::expand(0.0) - p, p);
+    }
+
+    // Antiderivative of softClip, 0 at 0: its even polynomial integral up
+    // to the knee, then rising as |u| (the clamp's slope is +-1)
+    static Lanes softClipIntegral(const Lanes& u)
+    {
+        const auto m = magnitude(u);
+        const auto a = Lanes::min(m, Lanes::expand(kKnee));
+        const auto q = Lanes::horner(a * a, Lanes::expand(1.4392808559283096e-09),
+                                     -9.823798833495854e-08, 2.8845359951207953e-06, -4.794332632063032e-05,
+                                     0.0005024679859173875, -0.0035516144898855343, 0.018338812831339753,
+                                     -0.0811592714415194, 0.5);
+
+        return a * a * q + (m - a);
+    }
+
+    static constexpr double kTubeBias = 0.3;
+    static constexpr double kTubeOffset = 0.291496062558713;         // softClip(kTubeBias)
+    static constexpr double kTubeNormalisation = 1.0909143385842575; // 1 / softClip'(kTubeBias): unity slope at 0
+
+    static Lanes shape(Curve c, const Lanes& u)
+    {
+        switch (c)
+        {
+            case Curve::tape: return softClip(u);
+            case Curve::tube:
+                return (softClip(u + Lanes::expand(kTubeBias)) - Lanes::expand(kTubeOffset))
+                       * Lanes::expand(kTubeNormalisation);
+            case Curve::off:  break;
+        }
+
+        return u;
+    }
+
+    static Lanes antiderivative(Curve c, const Lanes& u)
+    {
+        switch (c)
+        {
+            case Curve::tape: return softClipIntegral(u);
+            case Curve::tube:
+                return (softClipIntegral(u + Lanes::expand(kTubeBias)) - u * Lanes::expand(kTubeOffset))
+                       * Lanes::expand(kTubeNormalisation);
+            case Curve::off:  break;
+        }
+
+        return u * u * Lanes::expand(0.5);
+    }
+
+    void removeDc(float* x, size_t numSamples, size_t ch)
+    {
+        float in = dcIn[ch], out = dcOut[ch];
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            out = x[i] - in + dcCoefficient * out;
+            in = x[i];
+            x[i] = out;
+        }
+
+        dcIn[ch] = in;
+        dcOut[ch] = out;
+    }
+
+    Curve curve = Curve::off;
+
+    // Per-channel state carried across blocks, inline in the stage
+    size_t numChannels = 0;
+    Lanes lastDriven, lastIntegral;
+    std::array<float, kMaxChannels> dcIn {}, dcOut {};
+    float dcCoefficient = 0.9987f;
+};
@@ -0,0 +1,258 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+
+/**
+ * Stereo link - The Channel Strip
+ *
+ * Detection for the dynamics stages. At 100% link both channels follow the
+ * louder one (the per-sample max) and get the same gain. Below that every
+ * channel runs its own envelope on its own level pulled towards the louder
+ * one's by the link amount, so 0% is fully unlinked.
+ *
+ * The per-channel envelopes are held in Lanes: one SIMD register where the
+ * platform has them, so both channels update with one compare, one select
+ * and one multiply-add. JUCE has no SIMD log or pow, so Lanes carries its
+ * own dB conversions: a power-of-two range reduction (compares and selects)
+ * and a polynomial on the remaining octave. They are within
+ * kDecibelTolerance of juce::Decibels over the ranges below, which the
+ * stereo link tests check. The conversions are long dependency chains, so
+ * a stage runs them on whole registers of consecutive samples (load() and
+ * store()) rather than on one sample's two channels.
+ */
+namespace StereoLink
+{
+    inline constexpr size_t kMaxChannels = 2;
+
+    // Detector input of a channel: its own level pulled towards the loudest by `link` (0..1)
+    template <typename T>
+    inline T blend(T own, T loudest, T link)
+    {
+        return own + link * (loudest - own);
+    }
+
+    // ==============================================================================
+    // One value per channel
+    // ==============================================================================
+    // Largest difference (dB) of Lanes::gainToDecibels / decibelsToGain from
+    // juce::Decibels inside their ranges
+    inline constexpr float kDecibelTolerance = 1.0e-4f;
+
+    template <typename T>
+    class Lanes
+    {
+    public:
+        // gainToDecibels() input range; levels outside are clamped to it
+        static constexpr T kMinGain = T(1) / T(1 << 14);    // -84 dB
+        static constexpr T kMaxGain = T(1 << 10);           // +60 dB
+
+        // decibelsToGain() floor: anything quieter is held here
+        static constexpr T kMinDecibels = T(-144);
+
+        // Values a whole register holds: at least one per channel
+#if JUCE_USE_SIMD
+        static constexpr size_t width = juce::dsp::SIMDRegister<T>::SIMDNumElements;
+#else
+        static constexpr size_t width = kMaxChannels;
+#endif
+
+        Lanes() : Lanes(expand(T())) {}
+
+        static Lanes expand(T value)
+        {
+#if JUCE_USE_SIMD
+            return Lanes(Register::expand(value));
+#else
+            return Lanes(value);
+#endif
+        }
+
+        T get(size_t channel) const { return values.get(channel); }
+        void set(size_t channel, T value) { values.set(channel, value); }
+
+        // `width` consecutive values, from and to memory aligned to kAlignment
+        static constexpr size_t kAlignment = 64;
+
+        static Lanes load(const T* source)
+        {
+#if JUCE_USE_SIMD
+            return Lanes(Register::fromRawArray(source));
+#else
+            Lanes result;
+            std::copy(source, source + width, result.values.v.begin());
+            return result;
+#endif
+        }
+
+        void store(T* destination) const
+        {
+#if JUCE_USE_SIMD
+            values.copyToRawArray(destination);
+#else
+            std::copy(values.v.begin(), values.v.end(), destination);
+#endif
+        }
+
+        friend Lanes operator+(const Lanes& a, const Lanes& b) { return combine(a, b, [](auto x, auto y) { return x + y; }); }
+        friend Lanes operator-(const Lanes& a, const Lanes& b) { return combine(a, b, [](auto x, auto y) { return x - y; }); }
+        friend Lanes operator*(const Lanes& a, const Lanes& b) { return combine(a, b, [](auto x, auto y) { return x * y; }); }
+
+        static Lanes min(const Lanes& a, const Lanes& b)
+        {
+#if JUCE_USE_SIMD
+            return Lanes(Register::min(a.values, b.values));
+#else
+            return combine(a, b, [](T x, T y) { return juce::jmin(x, y); });
+#endif
+        }
+
+        static Lanes max(const Lanes& a, const Lanes& b)
+        {
+#if JUCE_USE_SIMD
+            return Lanes(Register::max(a.values, b.values));
+#else
+            return combine(a, b, [](T x, T y) { return juce::jmax(x, y); });
+#endif
+        }
+
+        // Per lane: `ifGreater` where a > b, `otherwise` elsewhere
+        static Lanes selectGreater(const Lanes& a, const Lanes& b, const Lanes& ifGreater, const Lanes& otherwise)
+        {
+#if JUCE_USE_SIMD
+            const auto greater = Register::greaterThan(a.values, b.values);
+            return Lanes((ifGreater.values & greater) + (otherwise.values & ~greater));
+#else
+            Lanes result;
+            for (size_t ch = 0; ch < kMaxChannels; ++ch)
+                result.set(ch, a.get(ch) > b.get(ch) ? ifGreater.get(ch) : otherwise.get(ch));
+            return result;
+#endif
+        }
+
+        // 20 log10(gain) for gains in [kMinGain, kMaxGain]
+        Lanes gainToDecibels() const
+        {
+            // Scaled into [1, 2^24] and halved by 2^16, 2^8 .. 2 wherever
+            // it is above: x ends in [1, 2] with its octave counted in e
+            auto x = min(max(*this, expand(kMinGain)), expand(kMaxGain)) * expand(T(1) / kMinGain);
+            auto e = expand(T(-14));
+
+            halveAbove<16>(x, e);
+            halveAbove<8>(x, e);
+            halveAbove<4>(x, e);
+            halveAbove<2>(x, e);
+            halveAbove<1>(x, e);
+
+            // log2(1 + u) on [0, 1], Chebyshev-node fit (error 3.7e-7)
+            const auto p = horner(x - expand(T(1)), expand(T(0.014440352494827833)),
+                                  T(-0.07565137468420746), T(0.18875273773570928), T(-0.3219602854610087),
+                                  T(0.47208691624394755), T(-0.7203160643590857), T(1.4426475487299195),
+                                  T(3.6856140957552955e-07));
+
+            return (e + p) * expand(T(6.020599913279624));    // 20 log10(2)
+        }
+
+        // 10^(dB / 20) for dB in [kMinDecibels, 0]; exactly 1 at 0 dB
+        Lanes decibelsToGain() const
+        {
+            // In octaves, raised by 16, 8 .. 1 wherever below minus that
+            // many: y ends in [-1, 0] and the octaves go into the scale
+            auto y = min(max(*this, expand(kMinDecibels)), expand(T(0))) * expand(T(0.16609640474436813));    // log2(10) / 20
+            auto scale = expand(T(1));
+
+            raiseBelow<16>(y, scale);
+            raiseBelow<8>(y, scale);
+            raiseBelow<4>(y, scale);
+            raiseBelow<2>(y, scale);
+            raiseBelow<1>(y, scale);
+
+            // 2^y on [-1, 0] as 1 + y q(y), Chebyshev-node fit (relative error 4.3e-7)
+            const auto q = horner(y, expand(T(0.0010036305140198275)),
+                                  T(0.009344231011724552), T(0.05540855953817865), T(0.24021468998034987),
+                                  T(0.6931469447018745));
+
+            return (expand(T(1)) + y * q) * scale;
+        }
+
+        // Polynomial in x by Horner's rule: sum holds the highest
+        // coefficient, the rest follow down to the constant term
+        static Lanes horner(const Lanes&, const Lanes& sum) { return sum; }
+
+        template <typename... Lower>
+        static Lanes horner(const Lanes& x, const Lanes& sum, T next, Lower... lower)
+        {
+            return horner(x, sum * x + expand(next), lower...);
+        }
+
+        // One-pole step towards `input`: riseCoef in lanes where the input is
+        // above the current value, fallCoef in the others
+        void follow(const Lanes& input, const Lanes& riseCoef, const Lanes& fallCoef)
+        {
+#if JUCE_USE_SIMD
+            const auto rising = Register::greaterThan(input.values, values);
+            const auto coef = (riseCoef.values & rising) + (fallCoef.values & ~rising);
+            values = coef * values + (Register::expand(T(1)) - coef) * input.values;
+#else
+            for (size_t ch = 0; ch < kMaxChannels; ++ch)
+            {
+                const T coef = input.get(ch) > get(ch) ? riseCoef.get(ch) : fallCoef.get(ch);
+                set(ch, coef * get(ch) + (T(1) - coef) * input.get(ch));
+            }
+#endif
+        }
+
+    private:
+        // Where x > 2^octaves: x divided by it and the octaves counted in e
+        template <int octaves>
+        static void halveAbove(Lanes& x, Lanes& e)
+        {
+            const auto step = expand(T(1 << octaves));
+            e = selectGreater(x, step, e + expand(T(octaves)), e);
+            x = selectGreater(x, step, x * expand(T(1) / T(1 << octaves)), x);
+        }
+
+        // Where y < -octaves: y raised by them and the scale divided by 2^octaves
+        template <int octaves>
+        static void raiseBelow(Lanes& y, Lanes& scale)
+        {
+            const auto floor = expand(T(-octaves));
+            scale = selectGreater(floor, y, scale * expand(T(1) / T(1 << octaves)), scale);
+            y = selectGreater(floor, y, y + expand(T(octaves)), y);
+        }
+
+#if JUCE_USE_SIMD
+        using Register = juce::dsp::SIMDRegister<T>;
+        static_assert(Register::SIMDNumElements >= kMaxChannels, "both channels must fit one register");
+
+        explicit Lanes(Register value) : values(value) {}
+
+        template <typename Op>
+        static Lanes combine(const Lanes& a, const Lanes& b, Op op)
+        {
+            return Lanes(op(a.values, b.values));
+        }
+
+        Register values;
+#else
+        struct Scalars
+        {
+            T get(size_t channel) const { return v[channel]; }
+            void set(size_t channel, T value) { v[channel] = value; }
+            std::array<T, kMaxChannels> v;
+        };
+
+        explicit Lanes(T value) { values.v.fill(value); }
+
+        template <typename Op>
+        static Lanes combine(const Lanes& a, const Lanes& b, Op op)
+        {
+            Lanes result;
+            for (size_t ch = 0; ch < kMaxChannels; ++ch)
+                result.set(ch, op(a.get(ch), b.get(ch)));
+            return result;
+        }
+
+        Scalars values;
+#endif
+    };
+}
@@ -0,0 +1,51 @@
+#include "EditorOpenTimeline.h"
+
+void EditorOpenTimeline::begin(bool webViewReused)
+{
+    start = juce::Time::getMillisecondCounterHiRes();
+    marks.fill(-1.0);
+    reused = webViewReused;
+    ++numOpens;
+}
+
+void EditorOpenTimeline::mark(Phase phase)
+{
+    if (numOpens == 0 || hasReached(phase))
+        return;
+
+    marks[(size_t) phase] = juce::Time::getMillisecondCounterHiRes() - start;
+}
+
+juce::String EditorOpenTimeline::toString() const
+{
+    juce::String text;
+    text << "Editor open #" << numOpens << (reused ? " (reused web view)" : " (new web view)");
+
+    for (int i = 0; i < kNumPhases; ++i)
+    {
+        const auto phase = static_cast<Phase>(i);
+        text << "\n  " << juce::String(getPhaseName(phase)).paddedRight(' ', 14);
+
+        if (hasReached(phase))
+            text << juce::String(getMs(phase), 2) << " ms";
+        else
+            text << "-";
+    }
+
+    return text;
+}
+
+const char* EditorOpenTimeline::getPhaseName(Phase phase)
+{
+    switch (phase)
+    {
+        case Phase::webViewReady:  return "webViewReady";
+        case Phase::pageRequested: return "pageRequested";
+        case Phase::indexServed:   return "indexServed";
+        case Phase::pageBooted:    return "pageBooted";
+        case Phase::firstUpdate:   return "firstUpdate";
+        case Phase::count:         break;
+    }
+
+    return "";
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+
+/**
+ * Editor-open timeline - The Channel Strip
+ *
+ * Timestamps each phase between the host asking for the editor and the page
+ * showing live data, relative to begin(). Phases a reopen skips (the web view
+ * is reused with its page already booted) read -1. Message thread only.
+ */
+class EditorOpenTimeline
+{
+public:
+    enum class Phase
+    {
+        webViewReady = 0,   // Browser created, or an existing one re-parented
+        pageRequested,      // goToURL issued (first open only)
+        indexServed,        // Resource provider returned index.html (first open only)
+        pageBooted,         // The page reported "pageReady", or was already booted
+        firstUpdate,        // First event delivered to the booted page
+        count
+    };
+
+    static constexpr int kNumPhases = static_cast<int>(Phase::count);
+
+    EditorOpenTimeline() { marks.fill(-1.0); }
+
+    void begin(bool webViewReused);
+
+    // Only the first mark of a phase after begin() counts
+    void mark(Phase phase);
+
+    bool hasReached(Phase phase) const { return marks[(size_t) phase] >= 0.0; }
+    bool isComplete() const { return hasReached(Phase::firstUpdate); }
+
+    // Milliseconds since begin(), or -1 if the phase was not reached
+    double getMs(Phase phase) const { return marks[(size_t) phase]; }
+
+    bool wasReused() const { return reused; }
+    int getNumOpens() const { return numOpens; }
+
+    juce::String toString() const;
+
+    static const char* getPhaseName(Phase phase);
+
+private:
+    double start = 0.0;
+    std::array<double, kNumPhases> marks;
+    bool reused = false;
+    int numOpens = 0;
+};
@@ -0,0 +1,227 @@
+#include "EditorWebView.h"
+
+namespace
+{
+    // Page events handed to the editor showing the view
+    const char* const clientEvents[] = {
+        "resetLoudness",
+        "resetOvers",
+        "storeSnapshot",
+        "recallSnapshot",
+        "requestTransferCurves",
+        "requestFrequencyResponse",
+        "getActivationStatus",
+#if THE_CHANNEL_STRIP_STAGE_TIMING
+        "dumpStageTimings",
+        "resetStageTimings",
+#endif
+    };
+
+    // Sent by the page once the app has mounted
+    constexpr const char* pageReadyEvent = "pageReady";
+
+    // Views holding a hidden page, oldest first (message thread only)
+    std::vector<EditorWebView*>& retainedViews()
+    {
+        static std::vector<EditorWebView*> views;
+        return views;
+    }
+
+    void forgetRetained(EditorWebView* view)
+    {
+        auto& views = retainedViews();
+        views.erase(std::remove(views.begin(), views.end(), view), views.end());
+    }
+
+    juce::String getMimeType(const juce::String& path)
+    {
+        if (path.endsWith(".html")) return "text/html";
+        if (path.endsWith(".css")) return "text/css";
+        if (path.endsWith(".js")) return "application/javascript";
+        if (path.endsWith(".json")) return "application/json";
+        if (path.endsWith(".png")) return "image/png";
+        if (path.endsWith(".svg")) return "image/svg+xml";
+        if (path.endsWith(".woff")) return "font/woff";
+        if (path.endsWith(".woff2")) return "font/woff2";
+        if (path.endsWith(".ttf")) return "font/ttf";
+        return "application/octet-stream";
+    }
+}
+
+EditorWebView::EditorWebView(juce::AudioProcessorValueTreeState& state)
+    : apvts(state)
+{
+}
+
+EditorWebView::~EditorWebView()
+{
+    jassert(client == nullptr);
+    stopTimer();
+    releaseBrowser();
+}
+
+juce::WebBrowserComponent& EditorWebView::open(Client& newClient)
+{
+    jassert(client == nullptr);
+    client = &newClient;
+
+    stopTimer();
+    forgetRetained(this);
+
+    const bool reused = browser != nullptr;
+    timeline.begin(reused);
+
+    if (!reused)
+        createBrowser();
+
+    timeline.mark(EditorOpenTimeline::Phase::webViewReady);
+
+    if (pageBooted)
+        timeline.mark(EditorOpenTimeline::Phase::pageBooted);
+
+    return *browser;
+}
+
+void EditorWebView::close(Client& oldClient)
+{
+    jassert(client == &oldClient);
+    juce::ignoreUnused(oldClient);
+    client = nullptr;
+
+    if (auto* parent = browser->getParentComponent())
+        parent->removeChildComponent(browser.get());
+
+    startTimer(kIdleReleaseMs);
+
+    auto& views = retainedViews();
+    views.push_back(this);
+
+    if ((int) views.size() > kMaxRetainedViews)
+        views.front()->releaseBrowser();
+}
+
+void EditorWebView::emit(const juce::Identifier& eventId, const juce::var& payload)
+{
+    // Only the editor holding the view emits; a released view has no browser
+    jassert(client != nullptr);
+    if (browser == nullptr)
+        return;
+
+    browser->emitEventIfBrowserIsVisible(eventId, payload);
+
+    if (pageBooted)
+        timeline.mark(EditorOpenTimeline::Phase::firstUpdate);
+}
+
+void EditorWebView::createBrowser()
+{
+    resourcesDir = findResourcesDirectory();
+    DBG("Resources dir: " + resourcesDir.getFullPathName());
+
+    auto options = parameterBindings.addTo(juce::WebBrowserComponent::Options()
+        .withBackend(juce::WebBrowserComponent::Options::Backend::webview2)
+        .withNativeIntegrationEnabled()
+        // Hidden between editors, but still booted and still receiving events
+        .withKeepPageLoadedWhenBrowserIsHidden()
+        .withResourceProvider([this](const juce::String& url) { return serve(url); }))
+        .withEventListener(pageReadyEvent, [this](const juce::var& payload) {
+            handlePageEvent(pageReadyEvent, payload);
+        })
+        // Windows-specific options
+        .withWinWebView2Options(
+            juce::WebBrowserComponent::Options::WinWebView2()
+                .withBackgroundColour(juce::Colour(0xFF0d0d0d))
+                .withStatusBarDisabled()
+                .withUserDataFolder(
+                    juce::File::getSpecialLocation(juce::File::tempDirectory)
+                        .getChildFile("TheChannelStrip_WebView2")));
+
+    for (const auto* eventId : clientEvents)
+    {
+        options = options.withEventListener(eventId, [this, id = juce::String(eventId)](const juce::var& payload) {
+            handlePageEvent(id, payload);
+        });
+    }
+
+    browser = std::make_unique<juce::WebBrowserComponent>(options);
+
+    // Attachments are made once and stay for the life of the view, so a
+    // hidden page never falls behind the parameters
+    parameterBindings.attach(apvts);
+
+#if THE_CHANNEL_STRIP_DEV_MODE
+    browser->goToURL("http://localhost:5173");
+    DBG("Loading dev server at localhost:5173");
+#else
+    browser->goToURL(browser->getResourceProviderRoot());
+    DBG("Loading from resource provider");
+#endif
+
+    timeline.mark(EditorOpenTimeline::Phase::pageRequested);
+}
+
+void EditorWebView::releaseBrowser()
+{
+    jassert(client == nullptr);
+    stopTimer();
+    forgetRetained(this);
+
+    // Clean up attachments BEFORE the browser
+    parameterBindings.detach();
+    browser.reset();
+    pageBooted = false;
+}
+
+void EditorWebView::timerCallback()
+{
+    releaseBrowser();
+}
+
+std::optional<juce::WebBrowserComponent::Resource> EditorWebView::serve(const juce::String& url)
+{
+    auto path = url;
+    if (path.startsWith("/")) path = path.substring(1);
+    if (path.isEmpty()) path = "index.html";
+
+    auto file = resourcesDir.getChildFile(path);
+    if (!file.existsAsFile()) return std::nullopt;
+
+    juce::MemoryBlock data;
+    file.loadFileAsData(data);
+
+    if (path == "index.html")
+        timeline.mark(EditorOpenTimeline::Phase::indexServed);
+
+    return juce::WebBrowserComponent::Resource{
+        std::vector<std::byte>(
+            reinterpret_cast<const std::byte*>(data.getData()),
+            reinterpret_cast<const std::byte*>(data.getData()) + data.getSize()),
+        getMimeType(path).toStdString()
+    };
+}
+
+void EditorWebView::handlePageEvent(const juce::String& eventId, const juce::var& payload)
+{
+    if (eventId == pageReadyEvent)
+    {
+        pageBooted = true;
+        timeline.mark(EditorOpenTimeline::Phase::pageBooted);
+    }
+
+    if (client != nullptr)
+        client->handlePageEvent(eventId, payload);
+}
+
+juce::File EditorWebView::findResourcesDirectory()
+{
+    auto executableFile = juce::File::getSpecialLocation(juce::File::currentExecutableFile);
+    auto executableDir = executableFile.getParentDirectory();
+
+    auto dir = executableDir.getChildFile("Resources").getChildFile("WebUI");
+    if (!dir.isDirectory())
+        dir = executableDir.getChildFile("WebUI");
+    if (!dir.isDirectory())
+        dir = executableDir.getParentDirectory().getChildFile("Resources").getChildFile("WebUI");
+
+    return dir;
+}
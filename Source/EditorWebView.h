@@ -0,0 +1,80 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_gui_extra/juce_gui_extra.h>
+#include "EditorOpenTimeline.h"
+#include "WebParameterBindings.h"
+
+/**
+ * Reusable editor web view - The Channel Strip
+ *
+ * The WebBrowserComponent, its parameter relays and their attachments, owned
+ * by the processor rather than the editor. The first editor creates them and
+ * loads the page. Closing the editor only un-parents the browser - the page
+ * stays loaded while hidden and the attachments keep feeding it parameter
+ * changes - so a reopen re-parents an already booted page showing current
+ * state: no browser creation, no page load, no app boot.
+ *
+ * A hidden page still costs a browser process's worth of memory, so it is
+ * only kept for so long: the browser is released once it has been hidden for
+ * kIdleReleaseMs, or straight away if more than kMaxRetainedViews instances
+ * are holding a hidden one (oldest first). The next open then loads the page
+ * again, like the first one.
+ *
+ * Page events go to whichever editor currently holds the view. Message
+ * thread only.
+ */
+class EditorWebView : private juce::Timer
+{
+public:
+    // The editor showing the view
+    struct Client
+    {
+        virtual ~Client() = default;
+        virtual void handlePageEvent(const juce::String& eventId, const juce::var& payload) = 0;
+    };
+
+    // Across every instance in the process
+    static constexpr int kMaxRetainedViews = 4;
+    static constexpr int kIdleReleaseMs = 120000;
+
+    explicit EditorWebView(juce::AudioProcessorValueTreeState& apvts);
+    ~EditorWebView() override;
+
+    // Starts the open timeline and returns the browser for the client to show,
+    // creating it and loading the page on the first open
+    juce::WebBrowserComponent& open(Client& client);
+    void close(Client& client);
+
+    // Sends an event to the page (the first one after it has booted completes
+    // the open timeline)
+    void emit(const juce::Identifier& eventId, const juce::var& payload);
+
+    bool isPageBooted() const { return pageBooted; }
+
+    const EditorOpenTimeline& getTimeline() const { return timeline; }
+
+private:
+    void createBrowser();
+    void releaseBrowser();
+
+    // Idle timeout of a hidden page
+    void timerCallback() override;
+    std::optional<juce::WebBrowserComponent::Resource> serve(const juce::String& url);
+    void handlePageEvent(const juce::String& eventId, const juce::var& payload);
+
+    static juce::File findResourcesDirectory();
+
+    juce::AudioProcessorValueTreeState& apvts;
+
+    // Relays exist BEFORE the WebBrowserComponent, attachments AFTER it
+    WebParameterBindings parameterBindings;
+    std::unique_ptr<juce::WebBrowserComponent> browser;
+    juce::File resourcesDir;
+
+    Client* client = nullptr;
+    bool pageBooted = false;
+    EditorOpenTimeline timeline;
+
+    JUCE_DECLARE_NON_COPYABLE(EditorWebView)
+};
@@ -0,0 +1,225 @@
+#include "FrequencyResponse.h"
+#include "ParameterIDs.h"
+#include "DSP/Equalizer.h"
+#include "DSP/HighPassFilter.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    float load(juce::AudioProcessorValueTreeState& apvts, const char* id)
+    {
+        return apvts.getRawParameterValue(id)->load();
+    }
+
+    using FVO = juce::FloatVectorOperations;
+}
+
+FrequencyResponse::FrequencyResponse(juce::AudioProcessorValueTreeState& state)
+    : apvts(state)
+{
+    for (auto* points : { &cos1, &sin1, &cos2, &sin2, &numRe, &numIm, &denRe, &denIm, &scratch,
+                          &magnitudeDb, &phaseDegrees })
+        points->assign(kNumPoints, 0.0f);
+
+    for (auto& band : bands)
+    {
+        band.settings.fill(std::numeric_limits<float>::quiet_NaN());
+        band.magnitudeDb.assign(kNumPoints, 0.0f);
+        band.phase.assign(kNumPoints, 0.0f);
+    }
+
+    updateTrigTables();
+}
+
+void FrequencyResponse::setSampleRate(double newSampleRate)
+{
+    if (newSampleRate <= 0.0)
+        newSampleRate = 48000.0;
+
+    if (juce::exactlyEqual(newSampleRate, sampleRate))
+        return;
+
+    sampleRate = newSampleRate;
+    updateTrigTables();
+
+    // Every band's response depends on the sample rate
+    for (auto& band : bands)
+        band.settings.fill(std::numeric_limits<float>::quiet_NaN());
+}
+
+void FrequencyResponse::updateTrigTables()
+{
+    const double ratio = (double) kMaxHz / (double) kMinHz;
+
+    for (int i = 0; i < kNumPoints; ++i)
+    {
+        // Points above Nyquist alias back like the digital filter itself does
+        const double hz = kMinHz * std::pow(ratio, (double) i / (double) (kNumPoints - 1));
+        const double w = juce::MathConstants<double>::twoPi * hz / sampleRate;
+
+        cos1[(size_t) i] = (float) std::cos(w);
+        sin1[(size_t) i] = (float) std::sin(w);
+        cos2[(size_t) i] = (float) std::cos(2.0 * w);
+        sin2[(size_t) i] = (float) std::sin(2.0 * w);
+    }
+}
+
+// ==============================================================================
+// Band designs
+// ==============================================================================
+
+FrequencyResponse::Settings FrequencyResponse::readSettings(int band) const
+{
+    const auto isOn = [this](const char* id) { return load(apvts, id) > 0.5f ? 1.0f : 0.0f; };
+
+    switch (band)
+    {
+        case hpf:     return { load(apvts, ParamIDs::hpfFreq), load(apvts, ParamIDs::hpfSlope), 0.0f };
+        case low:     return { load(apvts, ParamIDs::eqLowGain), load(apvts, ParamIDs::eqLowFreq), isOn(ParamIDs::eqLowShelf) };
+        case lowMid:  return { load(apvts, ParamIDs::eqLowMidGain), load(apvts, ParamIDs::eqLowMidFreq), load(apvts, ParamIDs::eqLowMidQ) };
+        case highMid: return { load(apvts, ParamIDs::eqHighMidGain), load(apvts, ParamIDs::eqHighMidFreq), load(apvts, ParamIDs::eqHighMidQ) };
+        case high:    return { load(apvts, ParamIDs::eqHighGain), load(apvts, ParamIDs::eqHighFreq), isOn(ParamIDs::eqHighShelf) };
+        default:      break;
+    }
+
+    jassertfalse;
+    return {};
+}
+
+std::array<float, 6> FrequencyResponse::design(int band, const Settings& s) const
+{
+    switch (band)
+    {
+        case hpf:     return HighPassFilter::designSection(sampleRate, s[0]);
+        case low:     return Equalizer::designLowBand(sampleRate, s[0], s[1], s[2] > 0.5f);
+        case lowMid:  return Equalizer::designPeakBand(sampleRate, s[0], s[1], s[2]);
+        case highMid: return Equalizer::designPeakBand(sampleRate, s[0], s[1], s[2]);
+        case high:    return Equalizer::designHighBand(sampleRate, s[0], s[1], s[2] > 0.5f);
+        default:      break;
+    }
+
+    jassertfalse;
+    return {};
+}
+
+int FrequencyResponse::getNumSections(int band, const Settings& s) const
+{
+    return band == hpf ? HighPassFilter::getNumSections(static_cast<int>(s[1])) : 1;
+}
+
+// ==============================================================================
+// Evaluation
+// ==============================================================================
+
+void FrequencyResponse::evaluate(Band& band, const std::array<float, 6>& c, int numSections)
+{
+    // H(e^jw) = (b0 + b1 e^-jw + b2 e^-2jw) / (a0 + a1 e^-jw + a2 e^-2jw)
+    const auto polynomial = [this](float k0, float k1, float k2, Points& re, Points& im)
+    {
+        // re = k0 + k1 cos(w) + k2 cos(2w)
+        FVO::copyWithMultiply(re.data(), cos1.data(), k1, kNumPoints);
+        FVO::addWithMultiply(re.data(), cos2.data(), k2, kNumPoints);
+        FVO::add(re.data(), k0, kNumPoints);
+
+        // im = -(k1 sin(w) + k2 sin(2w))
+        FVO::copyWithMultiply(im.data(), sin1.data(), -k1, kNumPoints);
+        FVO::addWithMultiply(im.data(), sin2.data(), -k2, kNumPoints);
+    };
+
+    polynomial(c[0], c[1], c[2], numRe, numIm);
+    polynomial(c[3], c[4], c[5], denRe, denIm);
+
+    // |H|^2 = |N|^2 / |D|^2
+    auto* magnitude = band.magnitudeDb.data();
+    FVO::multiply(magnitude, numRe.data(), numRe.data(), kNumPoints);
+    FVO::addWithMultiply(magnitude, numIm.data(), numIm.data(), kNumPoints);
+    FVO::multiply(scratch.data(), denRe.data(), denRe.data(), kNumPoints);
+    FVO::addWithMultiply(scratch.data(), denIm.data(), denIm.data(), kNumPoints);
+
+    // A cascade of identical sections scales the dB and phase by its length
+    const float dbScale = 10.0f * (float) numSections;
+
+    for (size_t i = 0; i < (size_t) kNumPoints; ++i)
+    {
+        const float power = magnitude[i] / juce::jmax(scratch[i], 1.0e-30f);
+        magnitude[i] = dbScale * std::log10(juce::jmax(power, 1.0e-30f));
+
+        // arg(N / D) = arg(N * conj(D))
+        const float re = numRe[i] * denRe[i] + numIm[i] * denIm[i];
+        const float im = numIm[i] * denRe[i] - numRe[i] * denIm[i];
+        band.phase[i] = (float) numSections * std::atan2(im, re);
+    }
+}
+
+void FrequencyResponse::combine()
+{
+    std::fill(magnitudeDb.begin(), magnitudeDb.end(), 0.0f);
+    std::fill(phaseDegrees.begin(), phaseDegrees.end(), 0.0f);
+
+    for (int b = 0; b < numBands; ++b)
+    {
+        if (! (b == hpf ? hpfEnabled : eqEnabled))
+            continue;
+
+        FVO::add(magnitudeDb.data(), bands[(size_t) b].magnitudeDb.data(), kNumPoints);
+        FVO::add(phaseDegrees.data(), bands[(size_t) b].phase.data(), kNumPoints);
+    }
+
+    // Wrap to (-180, 180] for display
+    for (auto& phase : phaseDegrees)
+        phase = juce::radiansToDegrees(std::remainder(phase, juce::MathConstants<float>::twoPi));
+}
+
+bool FrequencyResponse::update()
+{
+    bool changed = false;
+
+    const bool hpfOn = load(apvts, ParamIDs::hpfEnabled) > 0.5f;
+    const bool eqOn = load(apvts, ParamIDs::eqEnabled) > 0.5f;
+
+    if (hpfOn != hpfEnabled || eqOn != eqEnabled)
+    {
+        hpfEnabled = hpfOn;
+        eqEnabled = eqOn;
+        changed = true;
+    }
+
+    // Only the bands whose design inputs moved are re-evaluated
+    for (int b = 0; b < numBands; ++b)
+    {
+        auto& band = bands[(size_t) b];
+        const auto settings = readSettings(b);
+
+        if (settings == band.settings)
+            continue;
+
+        band.settings = settings;
+        evaluate(band, design(b, settings), getNumSections(b, settings));
+        changed = true;
+    }
+
+    if (changed)
+        combine();
+
+    return changed;
+}
+
+juce::var FrequencyResponse::toVar() const
+{
+    const auto toArray = [](const Points& points) {
+        juce::Array<juce::var> values;
+        values.ensureStorageAllocated(kNumPoints);
+        for (const float value : points)
+            values.add(value);
+        return juce::var(values);
+    };
+
+    juce::DynamicObject::Ptr data = new juce::DynamicObject();
+    data->setProperty("minHz", kMinHz);
+    data->setProperty("maxHz", kMaxHz);
+    data->setProperty("magnitudeDb", toArray(magnitudeDb));
+    data->setProperty("phaseDegrees", toArray(phaseDegrees));
+    return juce::var(data.get());
+}
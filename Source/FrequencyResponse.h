@@ -0,0 +1,70 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <array>
+#include <vector>
+
+/**
+ * EQ + HPF frequency response - The Channel Strip
+ *
+ * Combined magnitude and phase of the HPF cascade and the four EQ bands at
+ * 512 log-spaced frequencies, evaluated from the same biquad designs the DSP
+ * uses. Lives on the message thread. Each band caches its own response and
+ * is only re-evaluated when its design inputs (or the sample rate) change;
+ * enabling or disabling a section just re-sums the cached bands. The complex
+ * arithmetic runs through juce::FloatVectorOperations, so it is vectorised.
+ */
+class FrequencyResponse
+{
+public:
+    static constexpr int kNumPoints = 512;
+    static constexpr float kMinHz = 20.0f;
+    static constexpr float kMaxHz = 20000.0f;
+
+    explicit FrequencyResponse(juce::AudioProcessorValueTreeState& state);
+
+    // 0 (not prepared yet) falls back to 48 kHz
+    void setSampleRate(double newSampleRate);
+
+    // True if the combined response changed since the last call
+    bool update();
+
+    // { minHz, maxHz, magnitudeDb: [...], phaseDegrees: [...] } at kNumPoints
+    // log-spaced frequencies from minHz to maxHz
+    juce::var toVar() const;
+
+private:
+    enum BandIndex { hpf = 0, low, lowMid, highMid, high, numBands };
+
+    using Settings = std::array<float, 3>;
+    using Points = std::vector<float>;
+
+    struct Band
+    {
+        Settings settings;   // Design inputs the cache holds (NaN forces evaluation)
+        Points magnitudeDb;  // Whole cascade
+        Points phase;        // Radians, whole cascade
+    };
+
+    Settings readSettings(int band) const;
+    std::array<float, 6> design(int band, const Settings& settings) const;
+    int getNumSections(int band, const Settings& settings) const;
+
+    void updateTrigTables();
+    void evaluate(Band& band, const std::array<float, 6>& coefficients, int numSections);
+    void combine();
+
+    juce::AudioProcessorValueTreeState& apvts;
+    double sampleRate = 48000.0;
+
+    std::array<Band, numBands> bands;
+    bool hpfEnabled = false, eqEnabled = false;
+
+    // cos/sin of w and 2w per point for the current sample rate
+    Points cos1, sin1, cos2, sin2;
+
+    // Scratch for evaluate()
+    Points numRe, numIm, denRe, denIm, scratch;
+
+    Points magnitudeDb, phaseDegrees;
+};
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 /**
  * Parameter IDs - The Channel Strip
  * Must match identifiers used in:
@@ -14,6 +16,8 @@ namespace ParamIDs
     inline constexpr const char* inputGain = "inputGain";
     inline constexpr const char* inputPhase = "inputPhase";
     inline constexpr const char* inputPad = "inputPad";
+    inline constexpr const char* inputDrive = "inputDrive";
+    inline constexpr const char* inputSaturation = "inputSaturation";
 
     // ==============================================================================
     // High-Pass Filter
@@ -59,6 +63,10 @@ namespace ParamIDs
     inline constexpr const char* gateAttack = "gateAttack";
     inline constexpr const char* gateRelease = "gateRelease";
     inline constexpr const char* gateRange = "gateRange";
+    inline constexpr const char* gateHold = "gateHold";
+    inline constexpr const char* gateHysteresis = "gateHysteresis";
+    inline constexpr const char* gateLookahead = "gateLookahead";
+    inline constexpr const char* gateLink = "gateLink";
 
     // ==============================================================================
     // Compressor
@@ -70,6 +78,8 @@ namespace ParamIDs
     inline constexpr const char* compRelease = "compRelease";
     inline constexpr const char* compMakeup = "compMakeup";
     inline constexpr const char* compKnee = "compKnee";
+    inline constexpr const char* compLookahead = "compLookahead";
+    inline constexpr const char* compLink = "compLink";
 
     // ==============================================================================
     // Limiter
@@ -77,6 +87,7 @@ namespace ParamIDs
     inline constexpr const char* limiterEnabled = "limiterEnabled";
     inline constexpr const char* limiterCeiling = "limiterCeiling";
     inline constexpr const char* limiterRelease = "limiterRelease";
+    inline constexpr const char* limiterLink = "limiterLink";
 
     // ==============================================================================
     // Output Stage
@@ -84,4 +95,113 @@ namespace ParamIDs
     inline constexpr const char* outputGain = "outputGain";
     inline constexpr const char* outputWidth = "outputWidth";
     inline constexpr const char* masterBypass = "masterBypass";
+    inline constexpr const char* autoGain = "autoGain";
+
+    // ==============================================================================
+    // A/B Snapshots
+    // ==============================================================================
+    inline constexpr const char* snapshotCompare = "snapshotCompare";
+    inline constexpr const char* snapshotMorph = "snapshotMorph";
+
+    // ==============================================================================
+    // Routing
+    // ==============================================================================
+    inline constexpr const char* stageOrder = "stageOrder";
+
+    // ==============================================================================
+    // Channel Modes (L/R, Mid, Side, M/S per section)
+    // ==============================================================================
+    inline constexpr const char* eqMode = "eqMode";
+    inline constexpr const char* gateMode = "gateMode";
+    inline constexpr const char* compMode = "compMode";
+    inline constexpr const char* limiterMode = "limiterMode";
+
+    // ==============================================================================
+    // Stable numeric keys (binary state format)
+    // Append new parameters at the end - never reorder or reuse a value, saved
+    // sessions refer to parameters by these numbers.
+    // ==============================================================================
+    enum class Index : std::uint16_t
+    {
+        inputGain = 0,
+        inputPhase,
+        inputPad,
+        hpfEnabled,
+        hpfFreq,
+        hpfSlope,
+        eqEnabled,
+        eqLowGain,
+        eqLowFreq,
+        eqLowShelf,
+        eqLowMidGain,
+        eqLowMidFreq,
+        eqLowMidQ,
+        eqHighMidGain,
+        eqHighMidFreq,
+        eqHighMidQ,
+        eqHighGain,
+        eqHighFreq,
+        eqHighShelf,
+        gateEnabled,
+        gateThreshold,
+        gateAttack,
+        gateRelease,
+        gateRange,
+        compEnabled,
+        compThreshold,
+        compRatio,
+        compAttack,
+        compRelease,
+        compMakeup,
+        compKnee,
+        limiterEnabled,
+        limiterCeiling,
+        limiterRelease,
+        outputGain,
+        outputWidth,
+        masterBypass,
+        snapshotCompare,
+        snapshotMorph,
+        autoGain,
+        stageOrder,
+        eqMode,
+        gateMode,
+        compMode,
+        limiterMode,
+        inputDrive,
+        inputSaturation,
+        gateHold,
+        gateHysteresis,
+        gateLookahead,
+        compLookahead,
+        gateLink,
+        compLink,
+        limiterLink,
+        count
+    };
+
+    inline constexpr int numParameters = static_cast<int>(Index::count);
+
+    // String IDs in Index order
+    inline constexpr const char* all[numParameters] = {
+        inputGain, inputPhase, inputPad,
+        hpfEnabled, hpfFreq, hpfSlope,
+        eqEnabled, eqLowGain, eqLowFreq, eqLowShelf,
+        eqLowMidGain, eqLowMidFreq, eqLowMidQ,
+        eqHighMidGain, eqHighMidFreq, eqHighMidQ,
+        eqHighGain, eqHighFreq, eqHighShelf,
+        gateEnabled, gateThreshold, gateAttack, gateRelease, gateRange,
+        compEnabled, compThreshold, compRatio, compAttack, compRelease, compMakeup, compKnee,
+        limiterEnabled, limiterCeiling, limiterRelease,
+        outputGain, outputWidth, masterBypass,
+        snapshotCompare, snapshotMorph,
+        autoGain,
+        stageOrder,
+        eqMode, gateMode, compMode, limiterMode,
+        inputDrive, inputSaturation,
+        gateHold, gateHysteresis, gateLookahead, compLookahead,
+        gateLink, compLink, limiterLink
+    };
+
+    inline constexpr const char* idFor(Index index) { return all[static_cast<int>(index)]; }
 }
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <array>
+#include "ParameterIDs.h"
+
+/**
+ * Plain copy of every parameter value (denormalised, real units), indexed by
+ * ParamIDs::Index. The audio thread reads the APVTS atomics into one of these
+ * once per block and the DSP stages are fed from it.
+ */
+struct ParameterSet
+{
+    std::array<float, ParamIDs::numParameters> values {};
+
+    float operator[](ParamIDs::Index index) const { return values[static_cast<size_t>(index)]; }
+    float& operator[](ParamIDs::Index index) { return values[static_cast<size_t>(index)]; }
+
+    bool isOn(ParamIDs::Index index) const { return (*this)[index] > 0.5f; }
+};
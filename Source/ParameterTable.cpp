@@ -0,0 +1,71 @@
+#include "ParameterTable.h"
+#include "ProcessingChain.h"
+#include "DSP/LookaheadDelay.h"
+#include "DSP/MidSide.h"
+#include "DSP/Saturation.h"
+
+static_assert(juce::exactlyEqual(ParameterTable::kMaxLookaheadMs, LookaheadDelay::kMaxLookaheadMs),
+              "Lookahead parameter range must match the delay line");
+
+namespace ParameterTable
+{
+const juce::StringArray& getChoiceNames(Choices choices)
+{
+    static const juce::StringArray hpfSlopeNames { "12 dB/oct", "18 dB/oct", "24 dB/oct" };
+    static const juce::StringArray noNames;
+
+    switch (choices)
+    {
+        case Choices::saturationCurves: return Saturation::getCurveNames();
+        case Choices::hpfSlopes:        return hpfSlopeNames;
+        case Choices::stageOrders:      return ProcessingChain::getOrderNames();
+        case Choices::channelModes:     return MidSide::getModeNames();
+        case Choices::none:             break;
+    }
+
+    jassertfalse;
+    return noNames;
+}
+
+juce::AudioProcessorValueTreeState::ParameterLayout createLayout()
+{
+    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
+    params.reserve((size_t) numDescriptors);
+
+    for (const auto& d : descriptors)
+    {
+        const juce::ParameterID id { d.getID(), 1 };
+
+        switch (d.kind)
+        {
+            case Kind::slider:
+                params.push_back(std::make_unique<juce::AudioParameterFloat>(
+                    id,
+                    d.name,
+                    juce::NormalisableRange<float>(d.minValue, d.maxValue, d.interval, d.skew),
+                    d.defaultValue,
+                    juce::AudioParameterFloatAttributes().withLabel(d.label).withAutomatable(d.automatable)));
+                break;
+
+            case Kind::toggle:
+                params.push_back(std::make_unique<juce::AudioParameterBool>(
+                    id,
+                    d.name,
+                    d.defaultValue > 0.5f,
+                    juce::AudioParameterBoolAttributes().withAutomatable(d.automatable)));
+                break;
+
+            case Kind::choice:
+                params.push_back(std::make_unique<juce::AudioParameterChoice>(
+                    id,
+                    d.name,
+                    getChoiceNames(d.choices),
+                    static_cast<int>(d.defaultValue),
+                    juce::AudioParameterChoiceAttributes().withAutomatable(d.automatable)));
+                break;
+        }
+    }
+
+    return { params.begin(), params.end() };
+}
+}
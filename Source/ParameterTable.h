@@ -0,0 +1,186 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "ParameterIDs.h"
+
+/**
+ * Parameter descriptor table - The Channel Strip
+ * One constexpr entry per parameter, in host (layout) order. The APVTS
+ * layout and the editor's web relays and attachments are all generated from
+ * it, so adding a parameter means one ParamIDs entry plus one line here.
+ */
+namespace ParameterTable
+{
+    // Which relay / attachment pair the editor binds the parameter with
+    enum class Kind : std::uint8_t
+    {
+        slider,   // AudioParameterFloat   - WebSliderRelay
+        toggle,   // AudioParameterBool    - WebToggleButtonRelay
+        choice    // AudioParameterChoice  - WebComboBoxRelay
+    };
+
+    // Choice lists live with the code that interprets them
+    enum class Choices : std::uint8_t
+    {
+        none,
+        saturationCurves,
+        hpfSlopes,
+        stageOrders,
+        channelModes
+    };
+
+    struct Descriptor
+    {
+        ParamIDs::Index index;
+        Kind kind;
+        const char* name;
+        float minValue = 0.0f;
+        float maxValue = 1.0f;
+        float interval = 0.0f;
+        float skew = 1.0f;
+        float defaultValue = 0.0f;   // Toggle: 0 / 1, choice: item index
+        const char* label = "";
+        Choices choices = Choices::none;
+        bool automatable = true;
+
+        constexpr const char* getID() const { return ParamIDs::idFor(index); }
+    };
+
+    constexpr Descriptor slider(ParamIDs::Index index, const char* name, float minValue, float maxValue,
+                                float interval, float skew, float defaultValue, const char* label = "")
+    {
+        return { index, Kind::slider, name, minValue, maxValue, interval, skew, defaultValue, label, Choices::none };
+    }
+
+    constexpr Descriptor toggle(ParamIDs::Index index, const char* name, bool defaultValue)
+    {
+        return { index, Kind::toggle, name, 0.0f, 1.0f, 1.0f, 1.0f, defaultValue ? 1.0f : 0.0f, "", Choices::none };
+    }
+
+    constexpr Descriptor choice(ParamIDs::Index index, const char* name, Choices choices, int defaultIndex)
+    {
+        return { index, Kind::choice, name, 0.0f, 0.0f, 1.0f, 1.0f, (float) defaultIndex, "", choices };
+    }
+
+    // Settings that change the plugin latency: hosts only pick up a new
+    // latency between renders, so these are not offered for automation
+    constexpr Descriptor notAutomatable(Descriptor descriptor)
+    {
+        descriptor.automatable = false;
+        return descriptor;
+    }
+
+    // Matches LookaheadDelay::kMaxLookaheadMs (checked in ParameterTable.cpp)
+    inline constexpr float kMaxLookaheadMs = 10.0f;
+
+    using P = ParamIDs::Index;
+
+    inline constexpr Descriptor descriptors[] = {
+        // Input Stage
+        slider(P::inputGain, "Input Gain", -24.0f, 24.0f, 0.1f, 1.0f, 0.0f, "dB"),
+        toggle(P::inputPhase, "Phase Invert", false),
+        toggle(P::inputPad, "Pad (-20dB)", false),
+        slider(P::inputDrive, "Input Drive", 0.0f, 24.0f, 0.1f, 1.0f, 0.0f, "dB"),
+        choice(P::inputSaturation, "Input Saturation", Choices::saturationCurves, 0),
+
+        // High-Pass Filter
+        toggle(P::hpfEnabled, "HPF Enable", false),
+        slider(P::hpfFreq, "HPF Frequency", 20.0f, 500.0f, 1.0f, 0.4f, 80.0f, "Hz"),
+        choice(P::hpfSlope, "HPF Slope", Choices::hpfSlopes, 1),
+
+        // EQ Section
+        toggle(P::eqEnabled, "EQ Enable", true),
+        slider(P::eqLowGain, "Low Gain", -18.0f, 18.0f, 0.1f, 1.0f, 0.0f, "dB"),
+        slider(P::eqLowFreq, "Low Freq", 20.0f, 500.0f, 1.0f, 0.4f, 80.0f, "Hz"),
+        toggle(P::eqLowShelf, "Low Shelf", true),
+        slider(P::eqLowMidGain, "Low-Mid Gain", -18.0f, 18.0f, 0.1f, 1.0f, 0.0f, "dB"),
+        slider(P::eqLowMidFreq, "Low-Mid Freq", 100.0f, 2000.0f, 1.0f, 0.4f, 400.0f, "Hz"),
+        slider(P::eqLowMidQ, "Low-Mid Q", 0.1f, 10.0f, 0.01f, 0.5f, 1.0f),
+        slider(P::eqHighMidGain, "High-Mid Gain", -18.0f, 18.0f, 0.1f, 1.0f, 0.0f, "dB"),
+        slider(P::eqHighMidFreq, "High-Mid Freq", 500.0f, 8000.0f, 1.0f, 0.4f, 2500.0f, "Hz"),
+        slider(P::eqHighMidQ, "High-Mid Q", 0.1f, 10.0f, 0.01f, 0.5f, 1.0f),
+        slider(P::eqHighGain, "High Gain", -18.0f, 18.0f, 0.1f, 1.0f, 0.0f, "dB"),
+        slider(P::eqHighFreq, "High Freq", 2000.0f, 20000.0f, 1.0f, 0.4f, 12000.0f, "Hz"),
+        toggle(P::eqHighShelf, "High Shelf", true),
+
+        // Gate
+        toggle(P::gateEnabled, "Gate Enable", false),
+        slider(P::gateThreshold, "Gate Threshold", -80.0f, 0.0f, 0.1f, 1.0f, -40.0f, "dB"),
+        slider(P::gateAttack, "Gate Attack", 0.1f, 100.0f, 0.1f, 0.4f, 1.0f, "ms"),
+        slider(P::gateRelease, "Gate Release", 10.0f, 2000.0f, 1.0f, 0.4f, 100.0f, "ms"),
+        slider(P::gateRange, "Gate Range", -80.0f, 0.0f, 0.1f, 1.0f, -80.0f, "dB"),
+        slider(P::gateHold, "Gate Hold", 0.0f, 500.0f, 0.1f, 0.4f, 0.0f, "ms"),
+        slider(P::gateHysteresis, "Gate Hysteresis", 0.0f, 12.0f, 0.1f, 1.0f, 0.0f, "dB"),
+        notAutomatable(slider(P::gateLookahead, "Gate Lookahead", 0.0f, kMaxLookaheadMs, 0.1f, 1.0f, 0.0f, "ms")),
+        slider(P::gateLink, "Gate Stereo Link", 0.0f, 100.0f, 1.0f, 1.0f, 100.0f, "%"),
+
+        // Compressor
+        toggle(P::compEnabled, "Compressor Enable", false),
+        slider(P::compThreshold, "Comp Threshold", -60.0f, 0.0f, 0.1f, 1.0f, -20.0f, "dB"),
+        slider(P::compRatio, "Comp Ratio", 1.0f, 20.0f, 0.1f, 0.5f, 4.0f, ":1"),
+        slider(P::compAttack, "Comp Attack", 0.1f, 300.0f, 0.1f, 0.4f, 10.0f, "ms"),
+        slider(P::compRelease, "Comp Release", 10.0f, 3000.0f, 1.0f, 0.4f, 100.0f, "ms"),
+        slider(P::compMakeup, "Comp Makeup", -12.0f, 24.0f, 0.1f, 1.0f, 0.0f, "dB"),
+        slider(P::compKnee, "Comp Knee", 0.0f, 12.0f, 0.1f, 1.0f, 6.0f, "dB"),
+        notAutomatable(slider(P::compLookahead, "Comp Lookahead", 0.0f, kMaxLookaheadMs, 0.1f, 1.0f, 0.0f, "ms")),
+        slider(P::compLink, "Comp Stereo Link", 0.0f, 100.0f, 1.0f, 1.0f, 100.0f, "%"),
+
+        // Limiter
+        toggle(P::limiterEnabled, "Limiter Enable", false),
+        slider(P::limiterCeiling, "Limiter Ceiling", -12.0f, 0.0f, 0.1f, 1.0f, -0.3f, "dB"),
+        slider(P::limiterRelease, "Limiter Release", 10.0f, 1000.0f, 1.0f, 0.4f, 100.0f, "ms"),
+        slider(P::limiterLink, "Limiter Stereo Link", 0.0f, 100.0f, 1.0f, 1.0f, 100.0f, "%"),
+
+        // Output Stage
+        slider(P::outputGain, "Output Gain", -24.0f, 24.0f, 0.1f, 1.0f, 0.0f, "dB"),
+        slider(P::outputWidth, "Stereo Width", 0.0f, 200.0f, 1.0f, 1.0f, 100.0f, "%"),
+        toggle(P::masterBypass, "Master Bypass", false),
+        toggle(P::autoGain, "Auto Gain", false),
+
+        // A/B Snapshots
+        toggle(P::snapshotCompare, "Snapshot Compare", false),
+        slider(P::snapshotMorph, "Snapshot Morph", 0.0f, 100.0f, 0.1f, 1.0f, 0.0f, "%"),
+
+        // Routing
+        choice(P::stageOrder, "Stage Order", Choices::stageOrders, 0),
+
+        // Channel Modes
+        choice(P::eqMode, "EQ Mode", Choices::channelModes, 0),
+        choice(P::gateMode, "Gate Mode", Choices::channelModes, 0),
+        choice(P::compMode, "Comp Mode", Choices::channelModes, 0),
+        choice(P::limiterMode, "Limiter Mode", Choices::channelModes, 0),
+    };
+
+    inline constexpr int numDescriptors = (int) std::size(descriptors);
+
+    // Every parameter exactly once
+    constexpr bool coversEveryParameter()
+    {
+        if (numDescriptors != ParamIDs::numParameters)
+            return false;
+
+        bool seen[ParamIDs::numParameters] {};
+        for (const auto& descriptor : descriptors)
+        {
+            auto& entry = seen[static_cast<int>(descriptor.index)];
+            if (entry)
+                return false;
+            entry = true;
+        }
+        return true;
+    }
+
+    static_assert(coversEveryParameter(), "ParameterTable must list every ParamIDs::Index exactly once");
+
+    constexpr int countOf(Kind kind)
+    {
+        int count = 0;
+        for (const auto& descriptor : descriptors)
+            count += descriptor.kind == kind ? 1 : 0;
+        return count;
+    }
+
+    const juce::StringArray& getChoiceNames(Choices choices);
+
+    juce::AudioProcessorValueTreeState::ParameterLayout createLayout();
+}
@@ -1,13 +1,14 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "EditorWebView.h"
 #include "ParameterIDs.h"
-#include "DSP/InputStage.h"
-#include "DSP/HighPassFilter.h"
-#include "DSP/Equalizer.h"
-#include "DSP/Gate.h"
-#include "DSP/Compressor.h"
-#include "DSP/Limiter.h"
-#include "DSP/OutputStage.h"
+#include "ParameterTable.h"
+#include "DSP/Saturation.h"
+#include "DSP/LevelMeter.h"
+#include "DSP/LoudnessMeter.h"
+#include "StageArena.h"
+#include "ProcessingChain.h"
+#include "QualityProfile.h"
 
 TheChannelStripProcessor::TheChannelStripProcessor()
     : AudioProcessor(BusesProperties()
@@ -15,286 +16,30 @@ TheChannelStripProcessor::TheChannelStripProcessor()
                          .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
       apvts(*this, nullptr, "Parameters", createParameterLayout())
 {
-    // Create DSP modules
-    inputStage = std::make_unique<InputStage>();
-    highPassFilter = std::make_unique<HighPassFilter>();
-    equalizer = std::make_unique<Equalizer>();
-    gate = std::make_unique<Gate>();
-    compressor = std::make_unique<Compressor>();
-    limiter = std::make_unique<Limiter>();
-    outputStage = std::make_unique<OutputStage>();
+    // Create the modules the editor reads; the DSP stages wait for prepareToPlay
+    inputMeter = std::make_unique<LevelMeter>();
+    outputMeter = std::make_unique<LevelMeter>();
+    loudnessMeter = std::make_unique<LoudnessMeter>();
+
+#if THE_CHANNEL_STRIP_STAGE_TIMING
+    chainStages.profiler = &stageProfiler;
+#endif
+
+    for (int i = 0; i < ParamIDs::numParameters; ++i)
+        rawParameters[(size_t) i] = apvts.getRawParameterValue(ParamIDs::all[i]);
+
+    startTimerHz(10);
 }
 
 TheChannelStripProcessor::~TheChannelStripProcessor()
 {
+    stopTimer();
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout TheChannelStripProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    // ==============================================================================
-    // Input Stage
-    // ==============================================================================
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::inputGain, 1 },
-        "Input Gain",
-        juce::NormalisableRange<float>(-24.0f, 24.0f, 0.1f),
-        0.0f,
-        juce::AudioParameterFloatAttributes().withLabel("dB")));
-
-    params.push_back(std::make_unique<juce::AudioParameterBool>(
-        juce::ParameterID { ParamIDs::inputPhase, 1 },
-        "Phase Invert",
-        false));
-
-    params.push_back(std::make_unique<juce::AudioParameterBool>(
-        juce::ParameterID { ParamIDs::inputPad, 1 },
-        "Pad (-20dB)",
-        false));
-
-    // ==============================================================================
-    // High-Pass Filter
-    // ==============================================================================
-    params.push_back(std::make_unique<juce::AudioParameterBool>(
-        juce::ParameterID { ParamIDs::hpfEnabled, 1 },
-        "HPF Enable",
-        false));
-
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::hpfFreq, 1 },
-        "HPF Frequency",
-        juce::NormalisableRange<float>(20.0f, 500.0f, 1.0f, 0.4f),
-        80.0f,
-        juce::AudioParameterFloatAttributes().withLabel("Hz")));
-
-    params.push_back(std::make_unique<juce::AudioParameterChoice>(
-        juce::ParameterID { ParamIDs::hpfSlope, 1 },
-        "HPF Slope",
-        juce::StringArray { "12 dB/oct", "18 dB/oct", "24 dB/oct" },
-        1));
-
-    // ==============================================================================
-    // EQ Section
-    // ==============================================================================
-    params.push_back(std::make_unique<juce::AudioParameterBool>(
-        juce::ParameterID { ParamIDs::eqEnabled, 1 },
-        "EQ Enable",
-        true));
-
-    // Low Band
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::eqLowGain, 1 },
-        "Low Gain",
-        juce::NormalisableRange<float>(-18.0f, 18.0f, 0.1f),
-        0.0f,
-        juce::AudioParameterFloatAttributes().withLabel("dB")));
-
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::eqLowFreq, 1 },
-        "Low Freq",
-        juce::NormalisableRange<float>(20.0f, 500.0f, 1.0f, 0.4f),
-        80.0f,
-        juce::AudioParameterFloatAttributes().withLabel("Hz")));
-
-    params.push_back(std::make_unique<juce::AudioParameterBool>(
-        juce::ParameterID { ParamIDs::eqLowShelf, 1 },
-        "Low Shelf",
-        true));
-
-    // Low-Mid Band
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::eqLowMidGain, 1 },
-        "Low-Mid Gain",
-        juce::NormalisableRange<float>(-18.0f, 18.0f, 0.1f),
-        0.0f,
-        juce::AudioParameterFloatAttributes().withLabel("dB")));
-
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::eqLowMidFreq, 1 },
-        "Low-Mid Freq",
-        juce::NormalisableRange<float>(100.0f, 2000.0f, 1.0f, 0.4f),
-        400.0f,
-        juce::AudioParameterFloatAttributes().withLabel("Hz")));
-
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::eqLowMidQ, 1 },
-        "Low-Mid Q",
-        juce::NormalisableRange<float>(0.1f, 10.0f, 0.01f, 0.5f),
-        1.0f));
-
-    // High-Mid Band
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::eqHighMidGain, 1 },
-        "High-Mid Gain",
-        juce::NormalisableRange<float>(-18.0f, 18.0f, 0.1f),
-        0.0f,
-        juce::AudioParameterFloatAttributes().withLabel("dB")));
-
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::eqHighMidFreq, 1 },
-        "High-Mid Freq",
-        juce::NormalisableRange<float>(500.0f, 8000.0f, 1.0f, 0.4f),
-        2500.0f,
-        juce::AudioParameterFloatAttributes().withLabel("Hz")));
-
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::eqHighMidQ, 1 },
-        "High-Mid Q",
-        juce::NormalisableRange<float>(0.1f, 10.0f, 0.01f, 0.5f),
-        1.0f));
-
-    // High Band
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::eqHighGain, 1 },
-        "High Gain",
-        juce::NormalisableRange<float>(-18.0f, 18.0f, 0.1f),
-        0.0f,
-        juce::AudioParameterFloatAttributes().withLabel("dB")));
-
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::eqHighFreq, 1 },
-        "High Freq",
-        juce::NormalisableRange<float>(2000.0f, 20000.0f, 1.0f, 0.4f),
-        12000.0f,
-        juce::AudioParameterFloatAttributes().withLabel("Hz")));
-
-    params.push_back(std::make_unique<juce::AudioParameterBool>(
-        juce::ParameterID { ParamIDs::eqHighShelf, 1 },
-        "High Shelf",
-        true));
-
-    // ==============================================================================
-    // Gate
-    // ==============================================================================
-    params.push_back(std::make_unique<juce::AudioParameterBool>(
-        juce::ParameterID { ParamIDs::gateEnabled, 1 },
-        "Gate Enable",
-        false));
-
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::gateThreshold, 1 },
-        "Gate Threshold",
-        juce::NormalisableRange<float>(-80.0f, 0.0f, 0.1f),
-        -40.0f,
-        juce::AudioParameterFloatAttributes().withLabel("dB")));
-
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::gateAttack, 1 },
-        "Gate Attack",
-        juce::NormalisableRange<float>(0.1f, 100.0f, 0.1f, 0.4f),
-        1.0f,
-        juce::AudioParameterFloatAttributes().withLabel("ms")));
-
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::gateRelease, 1 },
-        "Gate Release",
-        juce::NormalisableRange<float>(10.0f, 2000.0f, 1.0f, 0.4f),
-        100.0f,
-        juce::AudioParameterFloatAttributes().withLabel("ms")));
-
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::gateRange, 1 },
-        "Gate Range",
-        juce::NormalisableRange<float>(-80.0f, 0.0f, 0.1f),
-        -80.0f,
-        juce::AudioParameterFloatAttributes().withLabel("dB")));
-
-    // ==============================================================================
-    // Compressor
-    // ==============================================================================
-    params.push_back(std::make_unique<juce::AudioParameterBool>(
-        juce::ParameterID { ParamIDs::compEnabled, 1 },
-        "Compressor Enable",
-        false));
-
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::compThreshold, 1 },
-        "Comp Threshold",
-        juce::NormalisableRange<float>(-60.0f, 0.0f, 0.1f),
-        -20.0f,
-        juce::AudioParameterFloatAttributes().withLabel("dB")));
-
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::compRatio, 1 },
-        "Comp Ratio",
-        juce::NormalisableRange<float>(1.0f, 20.0f, 0.1f, 0.5f),
-        4.0f,
-        juce::AudioParameterFloatAttributes().withLabel(":1")));
-
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::compAttack, 1 },
-        "Comp Attack",
-        juce::NormalisableRange<float>(0.1f, 300.0f, 0.1f, 0.4f),
-        10.0f,
-        juce::AudioParameterFloatAttributes().withLabel("ms")));
-
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::compRelease, 1 },
-        "Comp Release",
-        juce::NormalisableRange<float>(10.0f, 3000.0f, 1.0f, 0.4f),
-        100.0f,
-        juce::AudioParameterFloatAttributes().withLabel("ms")));
-
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::compMakeup, 1 },
-        "Comp Makeup",
-        juce::NormalisableRange<float>(-12.0f, 24.0f, 0.1f),
-        0.0f,
-        juce::AudioParameterFloatAttributes().withLabel("dB")));
-
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::compKnee, 1 },
-        "Comp Knee",
-        juce::NormalisableRange<float>(0.0f, 12.0f, 0.1f),
-        6.0f,
-        juce::AudioParameterFloatAttributes().withLabel("dB")));
-
-    // ==============================================================================
-    // Limiter
-    // ==============================================================================
-    params.push_back(std::make_unique<juce::AudioParameterBool>(
-        juce::ParameterID { ParamIDs::limiterEnabled, 1 },
-        "Limiter Enable",
-        false));
-
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::limiterCeiling, 1 },
-        "Limiter Ceiling",
-        juce::NormalisableRange<float>(-12.0f, 0.0f, 0.1f),
-        -0.3f,
-        juce::AudioParameterFloatAttributes().withLabel("dB")));
-
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::limiterRelease, 1 },
-        "Limiter Release",
-        juce::NormalisableRange<float>(10.0f, 1000.0f, 1.0f, 0.4f),
-        100.0f,
-        juce::AudioParameterFloatAttributes().withLabel("ms")));
-
-    // ==============================================================================
-    // Output Stage
-    // ==============================================================================
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::outputGain, 1 },
-        "Output Gain",
-        juce::NormalisableRange<float>(-24.0f, 24.0f, 0.1f),
-        0.0f,
-        juce::AudioParameterFloatAttributes().withLabel("dB")));
-
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::outputWidth, 1 },
-        "Stereo Width",
-        juce::NormalisableRange<float>(0.0f, 200.0f, 1.0f),
-        100.0f,
-        juce::AudioParameterFloatAttributes().withLabel("%")));
-
-    params.push_back(std::make_unique<juce::AudioParameterBool>(
-        juce::ParameterID { ParamIDs::masterBypass, 1 },
-        "Master Bypass",
-        false));
-
-    return { params.begin(), params.end() };
+    // Ranges, defaults and host order all come from the descriptor table
+    return ParameterTable::createLayout();
 }
 
 void TheChannelStripProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
@@ -303,176 +48,350 @@ void TheChannelStripProcessor::prepareToPlay(double sampleRate, int samplesPerBl
 
     juce::dsp::ProcessSpec spec;
     spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock * 2); // Headroom for variable buffer sizes
+    // processBlock feeds the stages fixed slices, so any host block size is safe
+    juce::ignoreUnused(samplesPerBlock);
+    spec.maximumBlockSize = static_cast<juce::uint32>(kSubBlockSize);
     spec.numChannels = 2;
 
-    inputStage->prepare(spec);
-    highPassFilter->prepare(spec);
-    equalizer->prepare(spec);
-    gate->prepare(spec);
-    compressor->prepare(spec);
-    limiter->prepare(spec);
-    outputStage->prepare(spec);
+    // Kept across re-prepares: the stages re-size their own buffers
+    if (stages == nullptr)
+    {
+        stages = std::make_unique<StageArena>();
+        stages->fillChainStages(chainStages);
+    }
+
+    stages->prepare(spec);
+
+    // Stages are prepared for both profiles; this one decides the paths until
+    // the host flips offline rendering (see setNonRealtime)
+    requestedProfile.store(QualityProfile::forHost(isNonRealtime()));
+    applyQualityProfile(requestedProfile.load());
+
+    // The lookahead settings already in the session decide the initial latency
+    auto& lookahead = stages->lookahead;
+    lookahead.setLookahead(LookaheadDelay::gate, apvts.getRawParameterValue(ParamIDs::gateLookahead)->load());
+    lookahead.setLookahead(LookaheadDelay::comp, apvts.getRawParameterValue(ParamIDs::compLookahead)->load());
+    lookahead.reset(); // From the first sample - nothing to crossfade from yet
+    runningLatency = lookahead.getLatencySamples();
+    pendingLatency.store(-1);
+    setLatencySamples(runningLatency);
+
+#if THE_CHANNEL_STRIP_STAGE_TIMING
+    stageProfiler.prepare(sampleRate);
+#endif
+
+    inputMeter->prepare(sampleRate);
+    outputMeter->prepare(sampleRate);
+    loudnessMeter->prepare(sampleRate, getTotalNumOutputChannels());
 }
 
 void TheChannelStripProcessor::releaseResources()
 {
-    inputStage->reset();
-    highPassFilter->reset();
-    equalizer->reset();
-    gate->reset();
-    compressor->reset();
-    limiter->reset();
-    outputStage->reset();
+    if (stages != nullptr)
+    {
+        stages->reset();
+        stages->lookahead.reset();
+    }
+
+    inputMeter->reset();
+    outputMeter->reset();
+
+    loudnessMeter->release();
 }
 
 void TheChannelStripProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
 {
     juce::ScopedNoDenormals noDenormals;
+    const int numSamples = buffer.getNumSamples();
+
+    // Hosts prepare before processing; don't crash on one that doesn't
+    jassert(stages != nullptr);
+    if (stages == nullptr)
+        return;
+
+    auto& inputStage = stages->inputStage;
+    auto& outputStage = stages->outputStage;
+    auto& loudnessMatcher = stages->loudnessMatcher;
+    auto& lookahead = stages->lookahead;
+    STAGE_TIMING_SCOPE(stageProfiler, total, numSamples);
+
     auto totalNumInputChannels = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
     // Clear unused channels
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-        buffer.clear(i, 0, buffer.getNumSamples());
-
-    // Measure input levels
-    if (totalNumInputChannels > 0)
-        inputLevelL.store(buffer.getMagnitude(0, 0, buffer.getNumSamples()));
-    if (totalNumInputChannels > 1)
-        inputLevelR.store(buffer.getMagnitude(1, 0, buffer.getNumSamples()));
+        buffer.clear(i, 0, numSamples);
+
+    inputMeter->process(buffer, totalNumInputChannels, numSamples);
+
+    // Read every parameter once; while comparing, the A/B snapshots replace
+    // the live values before anything reaches the stages
+    using P = ParamIDs::Index;
+    ParameterSet params;
+    readParameters(params);
+
+    if (params.isOn(P::snapshotCompare))
+        snapshotBank.morph(params, params[P::snapshotMorph] / 100.0f);
+
+    // A host that switches to offline rendering without re-preparing gets
+    // the offline profile from this block on
+    if (const auto mode = requestedProfile.load(); mode != qualityMode)
+        applyQualityProfile(mode);
+
+    // Lookahead and the profile's oversampling are latency. The lines
+    // crossfade to a new delay and the host hears about it from the message
+    // thread.
+    lookahead.setLookahead(LookaheadDelay::gate, params[P::gateLookahead]);
+    lookahead.setLookahead(LookaheadDelay::comp, params[P::compLookahead]);
+    if (lookahead.getLatencySamples() != runningLatency)
+    {
+        runningLatency = lookahead.getLatencySamples();
+        pendingLatency.store(runningLatency);
+    }
 
     // Check master bypass
-    bool bypassed = *apvts.getRawParameterValue(ParamIDs::masterBypass) > 0.5f;
+    bool bypassed = params.isOn(P::masterBypass);
 
     if (bypassed)
     {
         // Reset all stages to prevent clicks on re-enable
-        inputStage->reset();
-        highPassFilter->reset();
-        equalizer->reset();
-        gate->reset();
-        compressor->reset();
-        limiter->reset();
-        outputStage->reset();
-
-        // Copy input to output for metering
-        outputLevelL.store(inputLevelL.load());
-        outputLevelR.store(inputLevelR.load());
-        gateGR.store(0.0f);
-        compGR.store(0.0f);
-        limiterGR.store(0.0f);
+        stages->reset();
+        processBypassed(buffer);
         return;
     }
 
+    // Auto-gain measures the untouched input against the chain result below
+    const bool autoGainEnabled = params.isOn(P::autoGain);
+    if (autoGainEnabled && !autoGainWasEnabled)
+        loudnessMatcher.reset();
+    autoGainWasEnabled = autoGainEnabled;
+
+    const int stageOrder = static_cast<int>(params[P::stageOrder]);
+    const int enableMask = ProcessingChain::getEnableMask(params);
+
     juce::dsp::AudioBlock<float> block(buffer);
-    juce::dsp::ProcessContextReplacing<float> context(block);
+
+    // Mid/side sections: InputStage encodes and OutputStage decodes, so the
+    // matrix costs no extra passes over the buffer
+    const bool midSideEntry = block.getNumChannels() >= 2
+                           && ProcessingChain::startsInMidSide(params, stageOrder, enableMask);
+
+    inputStage.setGain(params[P::inputGain]);
+    inputStage.setPhaseInvert(params.isOn(P::inputPhase));
+    inputStage.setPad(params.isOn(P::inputPad));
+    const auto saturation = static_cast<Saturation::Curve>(static_cast<int>(params[P::inputSaturation]));
+
+    inputStage.setDrive(params[P::inputDrive]);
+    inputStage.setSaturation(saturation);
+    inputStage.setMidSideOutput(midSideEntry);
+
+    // Input gains that commute with everything up to OutputStage are applied
+    // in its matrix instead of costing InputStage a pass. Level commutes with
+    // a purely linear chain (and only if auto-gain isn't measuring it);
+    // polarity with anything but the asymmetric tube curve, since every
+    // detector is rectified.
+    const bool deferLevel = saturation == Saturation::Curve::off
+                         && !autoGainEnabled
+                         && !ProcessingChain::hasLevelDependentStage(enableMask);
+    const bool deferPolarity = saturation != Saturation::Curve::tube;
+    inputStage.setDeferredGains(deferLevel, deferPolarity);
+
+    outputStage.setGain(params[P::outputGain]);
+    outputStage.setWidth(params[P::outputWidth]);
+
+    // Reorderable stages: one compile-time generated variant per routing and
+    // enable mask, chosen once per block
+    const auto processChain = ProcessingChain::select(stageOrder, enableMask);
+    ProcessingChain::State chainState;
+    auto& inputLine = lookahead.getLine(LookaheadDelay::input);
 
     // ==============================================================================
-    // Signal Flow: Input -> HPF -> EQ -> Gate -> Comp -> Limiter -> Output
+    // Signal Flow: Input -> [HPF, EQ, Gate, Comp in the selected order] -> Limiter -> Output
+    // Every stage runs on one kSubBlockSize slice before the next slice starts,
+    // so the slice stays in L1 across the whole strip whatever the host block size
     // ==============================================================================
+    for (int start = 0; start < numSamples; start += kSubBlockSize)
+    {
+        const int length = juce::jmin(kSubBlockSize, numSamples - start);
+        auto subBlock = block.getSubBlock((size_t) start, (size_t) length);
+        juce::dsp::ProcessContextReplacing<float> context(subBlock);
 
-    // Input Stage
-    inputStage->setGain(*apvts.getRawParameterValue(ParamIDs::inputGain));
-    inputStage->setPhaseInvert(*apvts.getRawParameterValue(ParamIDs::inputPhase) > 0.5f);
-    inputStage->setPad(*apvts.getRawParameterValue(ParamIDs::inputPad) > 0.5f);
-    inputStage->process(context);
+        if (autoGainEnabled)
+            loudnessMatcher.measureInput(subBlock);
 
-    // High-Pass Filter
-    bool hpfEnabled = *apvts.getRawParameterValue(ParamIDs::hpfEnabled) > 0.5f;
-    if (hpfEnabled)
-    {
-        highPassFilter->setFrequency(*apvts.getRawParameterValue(ParamIDs::hpfFreq));
-        int slopeIndex = static_cast<int>(*apvts.getRawParameterValue(ParamIDs::hpfSlope));
-        highPassFilter->setSlope(slopeIndex);
-        highPassFilter->process(context);
-    }
+        // Keeps the bypass path's copy of the oversampling latency current.
+        // An undriven input stage owes the same latency without running its
+        // oversampler, so the slice itself goes through the tap.
+        if (inputLine.getDelay() > 0)
+        {
+            if (inputStage.needsInputDelay())
+                inputLine.delay(subBlock);
+            else
+                inputLine.push(subBlock);
+        }
 
-    // EQ
-    bool eqEnabled = *apvts.getRawParameterValue(ParamIDs::eqEnabled) > 0.5f;
-    if (eqEnabled)
-    {
-        equalizer->setLowBand(
-            *apvts.getRawParameterValue(ParamIDs::eqLowGain),
-            *apvts.getRawParameterValue(ParamIDs::eqLowFreq),
-            *apvts.getRawParameterValue(ParamIDs::eqLowShelf) > 0.5f
-        );
-        equalizer->setLowMidBand(
-            *apvts.getRawParameterValue(ParamIDs::eqLowMidGain),
-            *apvts.getRawParameterValue(ParamIDs::eqLowMidFreq),
-            *apvts.getRawParameterValue(ParamIDs::eqLowMidQ)
-        );
-        equalizer->setHighMidBand(
-            *apvts.getRawParameterValue(ParamIDs::eqHighMidGain),
-            *apvts.getRawParameterValue(ParamIDs::eqHighMidFreq),
-            *apvts.getRawParameterValue(ParamIDs::eqHighMidQ)
-        );
-        equalizer->setHighBand(
-            *apvts.getRawParameterValue(ParamIDs::eqHighGain),
-            *apvts.getRawParameterValue(ParamIDs::eqHighFreq),
-            *apvts.getRawParameterValue(ParamIDs::eqHighShelf) > 0.5f
-        );
-        equalizer->process(context);
-    }
+        // Input Stage
+        {
+            STAGE_TIMING_SCOPE(stageProfiler, input, length);
+            inputStage.process(context);
+        }
 
-    // Gate
-    bool gateEnabled = *apvts.getRawParameterValue(ParamIDs::gateEnabled) > 0.5f;
-    if (gateEnabled)
-    {
-        gate->setThreshold(*apvts.getRawParameterValue(ParamIDs::gateThreshold));
-        gate->setAttack(*apvts.getRawParameterValue(ParamIDs::gateAttack));
-        gate->setRelease(*apvts.getRawParameterValue(ParamIDs::gateRelease));
-        gate->setRange(*apvts.getRawParameterValue(ParamIDs::gateRange));
-        gate->process(context);
-        gateGR.store(gate->getGainReduction());
-    }
-    else
-    {
-        gateGR.store(0.0f);
-    }
+        chainState.midSide = midSideEntry;
+        processChain(chainStages, params, context, chainState);
 
-    // Compressor
-    bool compEnabled = *apvts.getRawParameterValue(ParamIDs::compEnabled) > 0.5f;
-    if (compEnabled)
-    {
-        compressor->setThreshold(*apvts.getRawParameterValue(ParamIDs::compThreshold));
-        compressor->setRatio(*apvts.getRawParameterValue(ParamIDs::compRatio));
-        compressor->setAttack(*apvts.getRawParameterValue(ParamIDs::compAttack));
-        compressor->setRelease(*apvts.getRawParameterValue(ParamIDs::compRelease));
-        compressor->setMakeup(*apvts.getRawParameterValue(ParamIDs::compMakeup));
-        compressor->setKnee(*apvts.getRawParameterValue(ParamIDs::compKnee));
-        compressor->process(context);
-        compGR.store(compressor->getGainReduction());
-    }
-    else
-    {
-        compGR.store(0.0f);
+        // A switched-off gate or compressor still owes its lookahead delay,
+        // in whichever matrix the chain left the slice
+        const auto delayThrough = [&](LookaheadDelay::Tap tap) {
+            auto& line = lookahead.getLine(tap);
+            line.setLayout(chainState.midSide);
+            line.delay(subBlock);
+        };
+
+        if (!params.isOn(P::gateEnabled))
+            delayThrough(LookaheadDelay::gate);
+        if (!params.isOn(P::compEnabled))
+            delayThrough(LookaheadDelay::comp);
+
+        // Output Stage
+        if (autoGainEnabled)
+            loudnessMatcher.measureOutput(subBlock, chainState.midSide);
+
+        {
+            STAGE_TIMING_SCOPE(stageProfiler, output, length);
+            outputStage.setCompensation(autoGainEnabled ? loudnessMatcher.getCompensation() : 1.0f);
+            outputStage.setMidSideInput(chainState.midSide);
+            const auto carried = inputStage.getCarriedGain();
+            outputStage.setCarriedGain(carried.ramp, carried.value);
+            outputStage.process(context);
+        }
     }
 
-    // Limiter
-    bool limiterEnabled = *apvts.getRawParameterValue(ParamIDs::limiterEnabled) > 0.5f;
-    if (limiterEnabled)
+    storeGainReduction(gateGR, chainState.meters.gate);
+    storeGainReduction(compGR, chainState.meters.comp);
+    storeGainReduction(limiterGR, chainState.meters.limiter);
+    gateLevelDb.store(chainState.meters.gateLevel);
+    compLevelDb.store(chainState.meters.compLevel);
+
+    const float compensation = autoGainEnabled ? loudnessMatcher.getCompensation() : 1.0f;
+    autoGainDb.store(juce::Decibels::gainToDecibels(compensation));
+
+    outputMeter->process(buffer, totalNumOutputChannels, numSamples);
+
+    loudnessMeter->push(buffer, numSamples);
+}
+
+void TheChannelStripProcessor::processBlockBypassed(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+{
+    juce::ScopedNoDenormals noDenormals;
+
+    jassert(stages != nullptr);
+    if (stages == nullptr)
+        return;
+
+    for (auto i = getTotalNumInputChannels(); i < getTotalNumOutputChannels(); ++i)
+        buffer.clear(i, 0, buffer.getNumSamples());
+
+    inputMeter->process(buffer, getTotalNumInputChannels(), buffer.getNumSamples());
+    processBypassed(buffer);
+}
+
+void TheChannelStripProcessor::processBypassed(juce::AudioBuffer<float>& buffer)
+{
+    storeGainReduction(gateGR, {});
+    storeGainReduction(compGR, {});
+    storeGainReduction(limiterGR, {});
+    gateLevelDb.store(-100.0f);
+    compLevelDb.store(-100.0f);
+
+    juce::dsp::AudioBlock<float> block(buffer);
+    for (const auto tap : { LookaheadDelay::gate, LookaheadDelay::comp, LookaheadDelay::input })
     {
-        limiter->setCeiling(*apvts.getRawParameterValue(ParamIDs::limiterCeiling));
-        limiter->setRelease(*apvts.getRawParameterValue(ParamIDs::limiterRelease));
-        limiter->process(context);
-        limiterGR.store(limiter->getGainReduction());
+        auto& line = stages->lookahead.getLine(tap);
+        line.setLayout(false);
+        line.delay(block);
     }
-    else
+
+    outputMeter->process(buffer, getTotalNumOutputChannels(), buffer.getNumSamples());
+    loudnessMeter->push(buffer, buffer.getNumSamples());
+}
+
+void TheChannelStripProcessor::resetLoudness()
+{
+    loudnessMeter->requestReset();
+}
+
+void TheChannelStripProcessor::resetOvers()
+{
+    inputMeter->resetOvers();
+    outputMeter->resetOvers();
+}
+
+void TheChannelStripProcessor::storeGainReduction(ChannelGainReduction& meter,
+                                                   const ProcessingChain::Meters::ChannelGainReduction& values)
+{
+    for (size_t ch = 0; ch < meter.size(); ++ch)
+        meter[ch].store(values[ch]);
+}
+
+void TheChannelStripProcessor::applyQualityProfile(QualityProfile::Mode mode)
+{
+    const auto& profile = QualityProfile::get(mode);
+
+    stages->inputStage.setOversampling(profile.driveOversampling);
+    stages->gate.setDoublePrecisionDetector(profile.doublePrecisionDetectors);
+    stages->compressor.setDoublePrecisionDetector(profile.doublePrecisionDetectors);
+    stages->equalizer.setTopology(profile.eqTopology);
+
+    stages->lookahead.setDelaySamples(LookaheadDelay::input, stages->inputStage.getLatencySamples());
+    qualityMode = mode;
+}
+
+void TheChannelStripProcessor::setNonRealtime(bool isNonRealtime) noexcept
+{
+    AudioProcessor::setNonRealtime(isNonRealtime);
+    requestedProfile.store(QualityProfile::forHost(isNonRealtime));
+}
+
+void TheChannelStripProcessor::timerCallback()
+{
+    const int latency = pendingLatency.exchange(-1);
+
+    if (latency >= 0 && latency != getLatencySamples())
+        setLatencySamples(latency);
+}
+
+void TheChannelStripProcessor::readParameters(ParameterSet& params) const
+{
+    for (size_t i = 0; i < rawParameters.size(); ++i)
+        params.values[i] = rawParameters[i]->load(std::memory_order_relaxed);
+}
+
+void TheChannelStripProcessor::storeSnapshot(int slot)
+{
+    ParameterSet params;
+    readParameters(params);
+    snapshotBank.store(slot, params);
+}
+
+void TheChannelStripProcessor::recallSnapshot(int slot)
+{
+    // Commits a snapshot to the real parameters (undoable in the host, unlike comparing)
+    const auto& snapshot = snapshotBank.get(slot);
+
+    for (int i = 0; i < ParamIDs::numParameters; ++i)
     {
-        limiterGR.store(0.0f);
-    }
+        if (SnapshotBank::isGlobal(static_cast<ParamIDs::Index>(i)))
+            continue;
 
-    // Output Stage
-    outputStage->setGain(*apvts.getRawParameterValue(ParamIDs::outputGain));
-    outputStage->setWidth(*apvts.getRawParameterValue(ParamIDs::outputWidth));
-    outputStage->process(context);
+        auto* param = apvts.getParameter(ParamIDs::all[i]);
+        const float normalised = param->convertTo0to1(snapshot.values[(size_t) i]);
 
-    // Measure output levels
-    if (totalNumOutputChannels > 0)
-        outputLevelL.store(buffer.getMagnitude(0, 0, buffer.getNumSamples()));
-    if (totalNumOutputChannels > 1)
-        outputLevelR.store(buffer.getMagnitude(1, 0, buffer.getNumSamples()));
+        if (std::abs(param->getValue() - normalised) > 1.0e-6f)
+            param->setValueNotifyingHost(normalised);
+    }
+
+    if (auto* compare = apvts.getParameter(ParamIDs::snapshotCompare))
+        compare->setValueNotifyingHost(0.0f);
 }
 
 juce::AudioProcessorEditor* TheChannelStripProcessor::createEditor()
@@ -480,27 +399,27 @@ juce::AudioProcessorEditor* TheChannelStripProcessor::createEditor()
     return new TheChannelStripEditor(*this);
 }
 
+EditorWebView& TheChannelStripProcessor::getEditorWebView()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if (editorWebView == nullptr)
+        editorWebView = std::make_unique<EditorWebView>(apvts);
+
+    return *editorWebView;
+}
+
 void TheChannelStripProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    auto state = apvts.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    xml->setAttribute("stateVersion", kStateVersion);
-    copyXmlToBinary(*xml, destData);
+    stateSerializer.save(destData);
 }
 
 void TheChannelStripProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
-    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
-
-    if (xmlState && xmlState->hasTagName(apvts.state.getType()))
+    // Reads both the binary format and XML states saved by 1.0
+    if (!stateSerializer.load(data, sizeInBytes))
     {
-        int loadedVersion = xmlState->getIntAttribute("stateVersion", 0);
-        apvts.replaceState(juce::ValueTree::fromXml(*xmlState));
-
-        if (loadedVersion != kStateVersion)
-        {
-            DBG("State version mismatch: loaded " << loadedVersion << ", expected " << kStateVersion);
-        }
+        DBG("Unrecognised plugin state (" << sizeInBytes << " bytes), keeping current parameters");
     }
 }
 
@@ -2,17 +2,21 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "ParameterSet.h"
+#include "SnapshotBank.h"
+#include "StateSerializer.h"
+#include "StageProfiler.h"
+#include "ProcessingChain.h"
 
 // Forward declarations
-class InputStage;
-class HighPassFilter;
-class Equalizer;
-class Gate;
-class Compressor;
-class Limiter;
-class OutputStage;
-
-class TheChannelStripProcessor : public juce::AudioProcessor
+class StageArena;
+class LoudnessMeter;
+class LevelMeter;
+class EditorWebView;
+namespace QualityProfile { enum class Mode : int; }
+
+class TheChannelStripProcessor : public juce::AudioProcessor,
+                                  private juce::Timer
 {
 public:
     TheChannelStripProcessor();
@@ -22,9 +26,22 @@ public:
     void releaseResources() override;
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
+    // The dry signal delayed by the reported latency. Unlike the master
+    // bypass parameter the stages keep their state, so processing picks up
+    // where it stopped (the console runs a strip that misses its deadline
+    // through here)
+    void processBlockBypassed(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
+    // Any thread (some hosts flip it from the audio callback): the profile
+    // follows at the start of the next block
+    void setNonRealtime(bool isNonRealtime) noexcept override;
+
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
 
+    // Message thread - created by the first editor and kept for later ones
+    EditorWebView& getEditorWebView();
+
     const juce::String getName() const override { return JucePlugin_Name; }
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
@@ -42,49 +59,123 @@ public:
 
     juce::AudioProcessorValueTreeState& getAPVTS() { return apvts; }
 
+    // ==============================================================================
+    // A/B snapshots (message thread)
+    // ==============================================================================
+    void storeSnapshot(int slot);
+    void recallSnapshot(int slot);
+
     // ==============================================================================
     // Metering data for UI visualization
     // ==============================================================================
-    float getInputLevelL() const { return inputLevelL.load(); }
-    float getInputLevelR() const { return inputLevelR.load(); }
-    float getOutputLevelL() const { return outputLevelL.load(); }
-    float getOutputLevelR() const { return outputLevelR.load(); }
-    float getGateGainReduction() const { return gateGR.load(); }
-    float getCompGainReduction() const { return compGR.load(); }
-    float getLimiterGainReduction() const { return limiterGR.load(); }
+    const LevelMeter& getInputMeter() const { return *inputMeter; }
+    const LevelMeter& getOutputMeter() const { return *outputMeter; }
+    void resetOvers();
+
+    // Deepest of both channels
+    float getGateGainReduction() const { return deepest(gateGR); }
+    float getCompGainReduction() const { return deepest(compGR); }
+    float getLimiterGainReduction() const { return deepest(limiterGR); }
+
+    // Per channel: L/R, or mid/side while the stage runs in a mid/side mode
+    float getGateGainReduction(int channel) const { return gateGR[(size_t) channel].load(); }
+    float getCompGainReduction(int channel) const { return compGR[(size_t) channel].load(); }
+    float getLimiterGainReduction(int channel) const { return limiterGR[(size_t) channel].load(); }
+    float getGateDetectorLevel() const { return gateLevelDb.load(); }
+    float getCompDetectorLevel() const { return compLevelDb.load(); }
+
+    float getAutoGainDb() const { return autoGainDb.load(); }
+
+    const LoudnessMeter& getLoudnessMeter() const { return *loudnessMeter; }
+    void resetLoudness();
+
+#if THE_CHANNEL_STRIP_STAGE_TIMING
+    StageProfiler& getStageProfiler() { return stageProfiler; }
+#endif
 
 private:
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+    void readParameters(ParameterSet& params) const;
+
+    // Hands the profile's settings to the stages and its latency to the
+    // lookahead line that carries it for the bypass path (audio thread safe:
+    // every stage is prepared for both profiles)
+    void applyQualityProfile(QualityProfile::Mode mode);
+
+    // Delays the block through every lookahead line, so the bypassed signal
+    // keeps the reported latency, and meters it
+    void processBypassed(juce::AudioBuffer<float>& buffer);
+
+    // Message thread - reports a latency the audio thread has moved to
+    void timerCallback() override;
+
     juce::AudioProcessorValueTreeState apvts;
+    SnapshotBank snapshotBank { apvts };
+    StateSerializer stateSerializer { apvts, snapshotBank };
+
+    // Raw APVTS values in ParamIDs::Index order
+    std::array<std::atomic<float>*, ParamIDs::numParameters> rawParameters {};
 
     // ==============================================================================
     // DSP Processing Stages
     // ==============================================================================
-    std::unique_ptr<InputStage> inputStage;
-    std::unique_ptr<HighPassFilter> highPassFilter;
-    std::unique_ptr<Equalizer> equalizer;
-    std::unique_ptr<Gate> gate;
-    std::unique_ptr<Compressor> compressor;
-    std::unique_ptr<Limiter> limiter;
-    std::unique_ptr<OutputStage> outputStage;
+    // Stages only ever see slices of this many samples (2 x 64 floats fit in L1
+    // with room for every stage's state)
+    static constexpr int kSubBlockSize = 64;
+
+    // Every per-slice stage in one cache-line-aligned block, allocated by the
+    // first prepareToPlay
+    std::unique_ptr<StageArena> stages;
+
+    // Non-owning view of the reorderable stages for ProcessingChain
+    ProcessingChain::Stages chainStages;
+
+    // Peak / RMS / over meters at the strip input and output
+    std::unique_ptr<LevelMeter> inputMeter;
+    std::unique_ptr<LevelMeter> outputMeter;
+
+    // Output loudness analysis (runs on its own worker thread)
+    std::unique_ptr<LoudnessMeter> loudnessMeter;
+
+    // Auto-gain (the matcher itself lives in the arena)
+    bool autoGainWasEnabled = false;
 
     // ==============================================================================
     // Metering
     // ==============================================================================
-    std::atomic<float> inputLevelL { 0.0f };
-    std::atomic<float> inputLevelR { 0.0f };
-    std::atomic<float> outputLevelL { 0.0f };
-    std::atomic<float> outputLevelR { 0.0f };
-    std::atomic<float> gateGR { 0.0f };
-    std::atomic<float> compGR { 0.0f };
-    std::atomic<float> limiterGR { 0.0f };
+    using ChannelGainReduction = std::array<std::atomic<float>, 2>;
+
+    static float deepest(const ChannelGainReduction& meter) { return juce::jmin(meter[0].load(), meter[1].load()); }
+    static void storeGainReduction(ChannelGainReduction& meter, const ProcessingChain::Meters::ChannelGainReduction& values);
+
+    ChannelGainReduction gateGR {};
+    ChannelGainReduction compGR {};
+    ChannelGainReduction limiterGR {};
+    std::atomic<float> gateLevelDb { -100.0f };
+    std::atomic<float> compLevelDb { -100.0f };
+    std::atomic<float> autoGainDb { 0.0f };
 
-    // State versioning
-    static constexpr int kStateVersion = 1;
+#if THE_CHANNEL_STRIP_STAGE_TIMING
+    StageProfiler stageProfiler;
+#endif
 
     // Sample rate for parameter smoothing
     double currentSampleRate = 44100.0;
 
+    // Profile the stages run (audio thread), and the one the host asked for
+    QualityProfile::Mode qualityMode {};
+    std::atomic<QualityProfile::Mode> requestedProfile {};
+
+    // Latency the stages run with (audio thread), and the value waiting for
+    // the message thread to report it (-1: nothing pending). The host
+    // listener chain behind setLatencySamples is not real-time safe.
+    int runningLatency = 0;
+    std::atomic<int> pendingLatency { -1 };
+
+    // Editor browser, kept between editors so reopening skips the page load
+    // (declared last: its attachments go before the APVTS)
+    std::unique_ptr<EditorWebView> editorWebView;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TheChannelStripProcessor)
 };
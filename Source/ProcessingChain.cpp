@@ -0,0 +1,356 @@
+#include "ProcessingChain.h"
+#include "DSP/HighPassFilter.h"
+#include "DSP/Equalizer.h"
+#include "DSP/Gate.h"
+#include "DSP/Compressor.h"
+#include "DSP/Limiter.h"
+#include "DSP/MidSide.h"
+#include <iterator>
+#include <tuple>
+
+namespace ProcessingChain
+{
+namespace
+{
+    using P = ParamIDs::Index;
+
+    enum class Slot { hpf, eq, gate, comp, limiter };
+
+    static_assert(static_cast<int>(Slot::limiter) + 1 == kNumSwitchableStages, "one enable bit per slot");
+
+    template <Slot... Slots>
+    struct Order {};
+
+    // ==============================================================================
+    // Available routings - the limiter always closes the chain. Append only:
+    // sessions store the index.
+    // ==============================================================================
+    using Orders = std::tuple<
+        Order<Slot::hpf,  Slot::eq,  Slot::gate, Slot::comp, Slot::limiter>,
+        Order<Slot::gate, Slot::hpf, Slot::eq,   Slot::comp, Slot::limiter>,
+        Order<Slot::hpf,  Slot::gate, Slot::comp, Slot::eq,  Slot::limiter>,
+        Order<Slot::gate, Slot::hpf, Slot::comp, Slot::eq,   Slot::limiter>>;
+
+    constexpr const char* kOrderNames[] = {
+        "HPF > EQ > Gate > Comp",
+        "Gate > HPF > EQ > Comp",
+        "HPF > Gate > Comp > EQ",
+        "Gate > HPF > Comp > EQ"
+    };
+
+    constexpr int kNumOrders = static_cast<int>(std::tuple_size_v<Orders>);
+    static_assert((int) std::size(kOrderNames) == kNumOrders, "every order needs a name");
+
+    constexpr int bit(Slot slot) { return 1 << static_cast<int>(slot); }
+
+    // The HPF has no mode - it is correct in either matrix
+    constexpr bool hasChannelMode(Slot slot) { return slot != Slot::hpf; }
+
+    inline MidSide::Mode getMode(Slot slot, const ParameterSet& params)
+    {
+        const auto mode = [&] {
+            switch (slot)
+            {
+                case Slot::eq:      return params[P::eqMode];
+                case Slot::gate:    return params[P::gateMode];
+                case Slot::comp:    return params[P::compMode];
+                case Slot::limiter: return params[P::limiterMode];
+                case Slot::hpf:     break;
+            }
+            return 0.0f;
+        }();
+
+        return static_cast<MidSide::Mode>(static_cast<int>(mode));
+    }
+
+    // ==============================================================================
+    // Run a moded stage on the channels its mode selects, converting the block
+    // first if the previous section left it in the other matrix
+    // ==============================================================================
+    template <Slot S, typename Stage>
+    inline void processInMode(Stage& stage, const ParameterSet& params, Context& context, State& state)
+    {
+        auto& block = context.getOutputBlock();
+
+        if (block.getNumChannels() < 2)
+        {
+            if constexpr (S == Slot::gate || S == Slot::comp)
+                if (auto* lookahead = stage.getLookahead())
+                    lookahead->setLayout(false);
+
+            stage.process(context);
+            return;
+        }
+
+        const auto mode = getMode(S, params);
+        const bool midSide = MidSide::needsMidSide(mode);
+
+        if (midSide != state.midSide)
+        {
+            if (midSide)
+                MidSide::encode(block);
+            else
+                MidSide::decode(block);
+
+            state.midSide = midSide;
+        }
+
+        const bool single = mode == MidSide::Mode::mid || mode == MidSide::Mode::side;
+        const size_t processed = mode == MidSide::Mode::side ? 1 : 0;
+
+        // The lookahead lanes keep following the same signals across mode
+        // changes: mid (or L) in lane 0, side (or R) in lane 1
+        if constexpr (S == Slot::gate || S == Slot::comp)
+            if (auto* lookahead = stage.getLookahead())
+                lookahead->setLayout(midSide, single ? processed : 0);
+
+        if (single)
+        {
+            auto channel = block.getSingleChannelBlock(processed);
+            Context channelContext(channel);
+            stage.process(channelContext);
+
+            // The untouched channel still has to go through the stage's
+            // lookahead, or mid and side would come apart
+            if constexpr (S == Slot::gate || S == Slot::comp)
+                if (auto* lookahead = stage.getLookahead())
+                    lookahead->delay(block.getSingleChannelBlock(1 - processed), 1);
+
+            return;
+        }
+
+        stage.process(context);
+    }
+
+    // ==============================================================================
+    // Fold a dynamics stage's per-channel gain reduction into the block's meter.
+    // A mid- or side-only section ran on one channel of the pair.
+    // ==============================================================================
+    template <Slot S, typename Stage>
+    inline void meterGainReduction(const Stage& stage, const ParameterSet& params, const Context& context,
+                                   Meters::ChannelGainReduction& meter)
+    {
+        const auto mode = getMode(S, params);
+        const bool single = context.getOutputBlock().getNumChannels() >= 2
+                            && (mode == MidSide::Mode::mid || mode == MidSide::Mode::side);
+
+        if (single)
+        {
+            const size_t processed = mode == MidSide::Mode::mid ? 0 : 1;
+            meter[processed] = juce::jmin(meter[processed], stage.getGainReduction(0));
+            return;
+        }
+
+        for (size_t ch = 0; ch < meter.size(); ++ch)
+            meter[ch] = juce::jmin(meter[ch], stage.getGainReduction(ch));
+    }
+
+    // ==============================================================================
+    // One enabled stage with its parameters applied
+    // ==============================================================================
+    template <Slot S>
+    inline void runSlot(const Stages& stages, const ParameterSet& params, Context& context, State& state)
+    {
+        [[maybe_unused]] const int numSamples = (int) context.getOutputBlock().getNumSamples();
+
+        if constexpr (S == Slot::hpf)
+        {
+            STAGE_TIMING_SCOPE(*stages.profiler, hpf, numSamples);
+            auto& hpf = *stages.highPassFilter;
+            hpf.setFrequency(params[P::hpfFreq]);
+            hpf.setSlope(static_cast<int>(params[P::hpfSlope]));
+            hpf.process(context);
+        }
+        else if constexpr (S == Slot::eq)
+        {
+            STAGE_TIMING_SCOPE(*stages.profiler, eq, numSamples);
+            auto& eq = *stages.equalizer;
+            eq.setLowBand(params[P::eqLowGain], params[P::eqLowFreq], params.isOn(P::eqLowShelf));
+            eq.setLowMidBand(params[P::eqLowMidGain], params[P::eqLowMidFreq], params[P::eqLowMidQ]);
+            eq.setHighMidBand(params[P::eqHighMidGain], params[P::eqHighMidFreq], params[P::eqHighMidQ]);
+            eq.setHighBand(params[P::eqHighGain], params[P::eqHighFreq], params.isOn(P::eqHighShelf));
+            processInMode<Slot::eq>(eq, params, context, state);
+        }
+        else if constexpr (S == Slot::gate)
+        {
+            STAGE_TIMING_SCOPE(*stages.profiler, gate, numSamples);
+            auto& gate = *stages.gate;
+            gate.setThreshold(params[P::gateThreshold]);
+            gate.setAttack(params[P::gateAttack]);
+            gate.setRelease(params[P::gateRelease]);
+            gate.setRange(params[P::gateRange]);
+            gate.setHold(params[P::gateHold]);
+            gate.setHysteresis(params[P::gateHysteresis]);
+            gate.setStereoLink(params[P::gateLink]);
+            processInMode<Slot::gate>(gate, params, context, state);
+            meterGainReduction<Slot::gate>(gate, params, context, state.meters.gate);
+            state.meters.gateLevel = gate.getDetectorLevel();
+        }
+        else if constexpr (S == Slot::comp)
+        {
+            STAGE_TIMING_SCOPE(*stages.profiler, comp, numSamples);
+            auto& comp = *stages.compressor;
+            comp.setThreshold(params[P::compThreshold]);
+            comp.setRatio(params[P::compRatio]);
+            comp.setAttack(params[P::compAttack]);
+            comp.setRelease(params[P::compRelease]);
+            comp.setMakeup(params[P::compMakeup]);
+            comp.setKnee(params[P::compKnee]);
+            comp.setStereoLink(params[P::compLink]);
+            processInMode<Slot::comp>(comp, params, context, state);
+            meterGainReduction<Slot::comp>(comp, params, context, state.meters.comp);
+            state.meters.compLevel = comp.getDetectorLevel();
+        }
+        else if constexpr (S == Slot::limiter)
+        {
+            STAGE_TIMING_SCOPE(*stages.profiler, limiter, numSamples);
+            auto& limiter = *stages.limiter;
+            limiter.setCeiling(params[P::limiterCeiling]);
+            limiter.setRelease(params[P::limiterRelease]);
+            limiter.setStereoLink(params[P::limiterLink]);
+            processInMode<Slot::limiter>(limiter, params, context, state);
+            meterGainReduction<Slot::limiter>(limiter, params, context, state.meters.limiter);
+
+            auto& ceilingLimiter = *stages.ceilingLimiter;
+            auto& block = context.getOutputBlock();
+
+            if (!state.midSide || block.getNumChannels() < 2)
+            {
+                // Back in L/R: clear the pass once, so the next mid/side mode
+                // starts it clean without a reset on every slice
+                if (!ceilingLimiter.isIdle())
+                    ceilingLimiter.reset();
+                return;
+            }
+
+            // Mid and side at the ceiling are up to twice it once decoded: the
+            // ceiling is a promise about L/R, so keep it there too
+            MidSide::decode(block);
+            state.midSide = false;
+
+            ceilingLimiter.setCeiling(params[P::limiterCeiling]);
+            ceilingLimiter.setRelease(params[P::limiterRelease]);
+            ceilingLimiter.setStereoLink(params[P::limiterLink]);
+            ceilingLimiter.process(context);
+
+            for (size_t ch = 0; ch < state.meters.limiter.size(); ++ch)
+                state.meters.limiter[ch] = juce::jmin(state.meters.limiter[ch], ceilingLimiter.getGainReduction(ch));
+        }
+    }
+
+    // ==============================================================================
+    // Chain and dispatch table generation
+    // ==============================================================================
+    // Disabled stages are compiled out of the variant rather than skipped
+    template <int Mask, typename OrderType>
+    struct Chain;
+
+    template <int Mask, Slot... Slots>
+    struct Chain<Mask, Order<Slots...>>
+    {
+        template <Slot S>
+        static inline void runIfEnabled(const Stages& stages, const ParameterSet& params, Context& context, State& state)
+        {
+            if constexpr ((Mask & bit(S)) != 0)
+                runSlot<S>(stages, params, context, state);
+        }
+
+        static void process(const Stages& stages, const ParameterSet& params, Context& context, State& state)
+        {
+            (runIfEnabled<Slots>(stages, params, context, state), ...);
+        }
+    };
+
+    using Row = std::array<Function, kNumMasks>;
+
+    template <typename OrderType, int... Masks>
+    constexpr Row makeRow(std::integer_sequence<int, Masks...>)
+    {
+        return { &Chain<Masks, OrderType>::process... };
+    }
+
+    template <size_t... Indices>
+    constexpr std::array<Row, kNumOrders> makeTable(std::index_sequence<Indices...>)
+    {
+        return { makeRow<std::tuple_element_t<Indices, Orders>>(std::make_integer_sequence<int, kNumMasks> {})... };
+    }
+
+    // kNumOrders x 32 variants, all instantiated here
+    constexpr auto kChains = makeTable(std::make_index_sequence<kNumOrders> {});
+
+    // The same orders as runtime slot lists, for startsInMidSide
+    using SlotList = std::array<Slot, kNumSwitchableStages>;
+
+    template <Slot... Slots>
+    constexpr SlotList slotsOf(Order<Slots...>)
+    {
+        static_assert(sizeof...(Slots) == kNumSwitchableStages, "every order lists every stage once");
+        return { Slots... };
+    }
+
+    template <size_t... Indices>
+    constexpr std::array<SlotList, kNumOrders> makeSlotTable(std::index_sequence<Indices...>)
+    {
+        return { slotsOf(std::tuple_element_t<Indices, Orders> {})... };
+    }
+
+    constexpr auto kOrderSlots = makeSlotTable(std::make_index_sequence<kNumOrders> {});
+}
+
+const juce::StringArray& getOrderNames()
+{
+    static const juce::StringArray names(kOrderNames, kNumOrders);
+    return names;
+}
+
+int getEnableMask(const ParameterSet& params)
+{
+    return (params.isOn(P::hpfEnabled) ? bit(Slot::hpf) : 0)
+         | (params.isOn(P::eqEnabled) ? bit(Slot::eq) : 0)
+         | (params.isOn(P::gateEnabled) ? bit(Slot::gate) : 0)
+         | (params.isOn(P::compEnabled) ? bit(Slot::comp) : 0)
+         | (params.isOn(P::limiterEnabled) ? bit(Slot::limiter) : 0);
+}
+
+bool hasLevelDependentStage(int enableMask)
+{
+    return (enableMask & (bit(Slot::gate) | bit(Slot::comp) | bit(Slot::limiter))) != 0;
+}
+
+bool startsInMidSide(const ParameterSet& params, int order, int enableMask)
+{
+    for (const auto slot : kOrderSlots[(size_t) juce::jlimit(0, kNumOrders - 1, order)])
+    {
+        if ((enableMask & bit(slot)) != 0 && hasChannelMode(slot))
+            return MidSide::needsMidSide(getMode(slot, params));
+    }
+
+    return false;
+}
+
+Function select(int order, int enableMask)
+{
+    const auto& row = kChains[(size_t) juce::jlimit(0, kNumOrders - 1, order)];
+    return row[(size_t) (enableMask & (kNumMasks - 1))];
+}
+
+void processBranched(const Stages& stages, const ParameterSet& params, int order, Context& context, State& state)
+{
+    const int enableMask = getEnableMask(params);
+
+    for (const auto slot : kOrderSlots[(size_t) juce::jlimit(0, kNumOrders - 1, order)])
+    {
+        if ((enableMask & bit(slot)) == 0)
+            continue;
+
+        switch (slot)
+        {
+            case Slot::hpf:     runSlot<Slot::hpf>(stages, params, context, state); break;
+            case Slot::eq:      runSlot<Slot::eq>(stages, params, context, state); break;
+            case Slot::gate:    runSlot<Slot::gate>(stages, params, context, state); break;
+            case Slot::comp:    runSlot<Slot::comp>(stages, params, context, state); break;
+            case Slot::limiter: runSlot<Slot::limiter>(stages, params, context, state); break;
+        }
+    }
+}
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+#include "ParameterSet.h"
+#include "StageProfiler.h"
+
+class HighPassFilter;
+class Equalizer;
+class Gate;
+class Compressor;
+class Limiter;
+
+/**
+ * Processing chain - The Channel Strip
+ *
+ * The reorderable middle of the strip (HPF, EQ, Gate, Comp, Limiter) between
+ * the fixed Input and Output stages. Every combination of routing (the
+ * stageOrder parameter) and enable mask is its own function, generated from
+ * a compile-time stage list: disabled stages are not in the variant at all
+ * and the enabled ones are inlined into one body. processBlock picks the
+ * variant with a single table lookup per block - no virtual calls, no
+ * runtime stage lists, no per-stage enable branches.
+ *
+ * EQ, Gate, Comp and Limiter each have a channel mode (L/R, Mid, Side, M/S).
+ * The block is kept in one matrix for as long as possible: InputStage hands
+ * over mid/side when the first section that cares wants it, OutputStage
+ * decodes inside its width matrix, and the chain only converts in between
+ * where an L/R section meets a mid/side one. The HPF is linear and identical
+ * on both channels, so it runs in whichever matrix it finds.
+ *
+ * The limiter is a deliberate exception to "convert once at entry and
+ * exit": holding mid and side at the ceiling still lets L = M + S reach
+ * twice it, so a mid/side limiter is followed by a decode and a second, L/R
+ * pass at the same ceiling. Bounding |M| + |S| instead would only work for
+ * the M/S mode - a mid- or side-only limiter cannot hold L/R while the other
+ * channel alone is over the ceiling. In a mid/side mode the limiter costs
+ * about twice its L/R time plus a decode; the "Limiter channel modes"
+ * benchmark reports it.
+ */
+namespace ProcessingChain
+{
+    struct Stages
+    {
+        HighPassFilter* highPassFilter = nullptr;
+        Equalizer* equalizer = nullptr;
+        Gate* gate = nullptr;
+        Compressor* compressor = nullptr;
+        Limiter* limiter = nullptr;
+        Limiter* ceilingLimiter = nullptr;  // L/R pass behind a mid/side limiter
+
+#if THE_CHANNEL_STRIP_STAGE_TIMING
+        StageProfiler* profiler = nullptr;
+#endif
+    };
+
+    // Deepest gain reduction (negative dB) per channel reported by the dynamics
+    // stages over the block's slices (0 when off), in the matrix each stage ran
+    // in: L/R, or mid/side for a mid/side section
+    struct Meters
+    {
+        using ChannelGainReduction = std::array<float, 2>;
+
+        ChannelGainReduction gate {};
+        ChannelGainReduction comp {};
+        ChannelGainReduction limiter {};
+
+        // Detector levels at the end of the block for the transfer-curve dots (dB)
+        float gateLevel = -100.0f;
+        float compLevel = -100.0f;
+    };
+
+    struct State
+    {
+        bool midSide = false; // Matrix of the slice - set on entry, read on exit
+        Meters meters;
+    };
+
+    // Enable bits in default order: HPF, EQ, Gate, Comp, Limiter
+    inline constexpr int kNumSwitchableStages = 5;
+    inline constexpr int kNumMasks = 1 << kNumSwitchableStages;
+
+    using Context = juce::dsp::ProcessContextReplacing<float>;
+    using Function = void (*)(const Stages&, const ParameterSet&, Context&, State&);
+
+    // Choices of the stageOrder parameter, in index order
+    const juce::StringArray& getOrderNames();
+
+    int getEnableMask(const ParameterSet& params);
+
+    // Whether an enabled stage's output depends on the level it is fed (gate,
+    // compressor, limiter) - with none, a static gain commutes with the chain
+    bool hasLevelDependentStage(int enableMask);
+
+    // Whether the first enabled section that has a channel mode wants mid/side,
+    // i.e. the matrix InputStage should hand the chain
+    bool startsInMidSide(const ParameterSet& params, int order, int enableMask);
+
+    // Audio thread - the variant for a stageOrder value and enable mask
+    Function select(int order, int enableMask);
+
+    // The same stage calls walked at runtime, one enable branch and one
+    // switch per slot - the baseline the specialised variants are measured
+    // against, doing exactly the same work
+    void processBranched(const Stages& stages, const ParameterSet& params, int order, Context& context, State& state);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "DSP/InputStage.h"
+#include "DSP/Equalizer.h"
+
+/**
+ * Quality profiles - The Channel Strip
+ *
+ * Live tracking wants the least CPU and latency, an offline bounce the best
+ * result. The processor picks the profile from isNonRealtime() in
+ * prepareToPlay, and again at the start of the next block when the host
+ * calls setNonRealtime() without re-preparing. Every stage is prepared for
+ * both profiles, so switching on the audio thread only swaps code paths and
+ * clears filter state; the latency change is reported from the message
+ * thread along with the lookahead's.
+ */
+namespace QualityProfile
+{
+    // Fixed underlying type so PluginProcessor.h can declare it opaquely
+    enum class Mode : int
+    {
+        realtime = 0,
+        offline
+    };
+
+    struct Settings
+    {
+        int driveOversampling;          // Input drive oversampling factor (1: ADAA alone)
+        bool doublePrecisionDetectors;  // Gate / compressor envelopes
+        Equalizer::Topology eqTopology;
+    };
+
+    inline constexpr Settings realtime { 1, false, Equalizer::Topology::transposedDirectFormII };
+    inline constexpr Settings offline { InputStage::kOversamplingFactor, true, Equalizer::Topology::directFormIDouble };
+
+    constexpr const Settings& get(Mode mode)
+    {
+        return mode == Mode::offline ? offline : realtime;
+    }
+
+    constexpr Mode forHost(bool isNonRealtime)
+    {
+        return isNonRealtime ? Mode::offline : Mode::realtime;
+    }
+}
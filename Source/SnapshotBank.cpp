@@ -0,0 +1,113 @@
+#include "SnapshotBank.h"
+#include <thread>
+
+SnapshotBank::SnapshotBank(juce::AudioProcessorValueTreeState& apvts)
+{
+    ParameterSet defaults;
+
+    for (int i = 0; i < ParamIDs::numParameters; ++i)
+    {
+        auto* param = apvts.getParameter(ParamIDs::all[i]);
+        jassert(param != nullptr);
+
+        ranges[(size_t) i] = param->getNormalisableRange();
+        discrete[(size_t) i] = param->isDiscrete() || param->isBoolean();
+        defaults.values[(size_t) i] = param->convertFrom0to1(param->getDefaultValue());
+    }
+
+    editSlots.fill(defaults);
+    buffers.fill(editSlots);
+    audioSlots = editSlots;
+}
+
+void SnapshotBank::store(int slot, const ParameterSet& values)
+{
+    jassert(juce::isPositiveAndBelow(slot, kNumSlots));
+    editSlots[(size_t) slot] = values;
+    publish();
+}
+
+void SnapshotBank::storeAll(const Slots& values)
+{
+    editSlots = values;
+    publish();
+}
+
+void SnapshotBank::publish()
+{
+    const int back = 1 - frontIndex.load();
+
+    // The audio thread only holds a buffer for the length of one copy
+    while (readingIndex.load() == back)
+        std::this_thread::yield();
+
+    buffers[(size_t) back] = editSlots;
+    frontIndex.store(back);
+    publishedVersion.fetch_add(1);
+}
+
+void SnapshotBank::pullLatest()
+{
+    const auto version = publishedVersion.load();
+    if (version == audioVersion)
+        return;
+
+    int index = frontIndex.load();
+    readingIndex.store(index);
+
+    // A publish may have flipped the buffers before we claimed one
+    while (frontIndex.load() != index)
+    {
+        index = frontIndex.load();
+        readingIndex.store(index);
+    }
+
+    audioSlots = buffers[(size_t) index];
+    readingIndex.store(-1);
+    audioVersion = version;
+}
+
+void SnapshotBank::morph(ParameterSet& params, float position)
+{
+    pullLatest();
+
+    const float scaled = juce::jlimit(0.0f, 1.0f, position) * (float) (kNumSlots - 1);
+    const int lower = juce::jmin((int) scaled, kNumSlots - 2);
+    const float t = scaled - (float) lower;
+
+    const auto& from = audioSlots[(size_t) lower];
+    const auto& to = audioSlots[(size_t) lower + 1];
+
+    for (int i = 0; i < ParamIDs::numParameters; ++i)
+    {
+        if (isGlobal(static_cast<ParamIDs::Index>(i)))
+            continue;
+
+        const auto idx = (size_t) i;
+
+        if (discrete[idx])
+        {
+            // Switches and choices flip half way
+            params.values[idx] = t < 0.5f ? from.values[idx] : to.values[idx];
+        }
+        else
+        {
+            // Blend in normalised space so skewed ranges (Hz, ms) move perceptually
+            const auto& range = ranges[idx];
+            const float a = range.convertTo0to1(from.values[idx]);
+            const float b = range.convertTo0to1(to.values[idx]);
+            params.values[idx] = range.convertFrom0to1(a + (b - a) * t);
+        }
+    }
+}
+
+bool SnapshotBank::isGlobal(ParamIDs::Index index)
+{
+    return index == ParamIDs::Index::masterBypass
+        || index == ParamIDs::Index::autoGain
+        || index == ParamIDs::Index::snapshotCompare
+        || index == ParamIDs::Index::snapshotMorph
+        // Latency: a morph must not sweep it
+        || index == ParamIDs::Index::gateLookahead
+        || index == ParamIDs::Index::compLookahead;
+}
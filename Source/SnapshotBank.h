@@ -0,0 +1,60 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "ParameterSet.h"
+
+/**
+ * A/B Snapshots - The Channel Strip
+ *
+ * In-memory parameter sets the engineer can compare without rewriting APVTS
+ * parameters. The message thread edits the slots and publishes them through a
+ * double buffer; the audio thread picks up the latest published copy at block
+ * start and never waits.
+ *
+ * While comparing, the morph position (0 = first slot, 1 = last slot) blends
+ * neighbouring slots once per block. The result is fed through the normal
+ * parameter setters, so it is smoothed exactly like host automation.
+ */
+class SnapshotBank
+{
+public:
+    static constexpr int kNumSlots = 2;
+    using Slots = std::array<ParameterSet, kNumSlots>;
+
+    explicit SnapshotBank(juce::AudioProcessorValueTreeState& apvts);
+
+    // ==============================================================================
+    // Message thread
+    // ==============================================================================
+    void store(int slot, const ParameterSet& values);
+    void storeAll(const Slots& values);
+    const ParameterSet& get(int slot) const { return editSlots[(size_t) slot]; }
+
+    // ==============================================================================
+    // Audio thread
+    // ==============================================================================
+
+    // Replaces the morphable entries of `params` with the blend at `position` (0-1)
+    void morph(ParameterSet& params, float position);
+
+    // Parameters that stay live while comparing and are never recalled
+    static bool isGlobal(ParamIDs::Index index);
+
+private:
+    void publish();
+    void pullLatest();
+
+    std::array<juce::NormalisableRange<float>, ParamIDs::numParameters> ranges;
+    std::array<bool, ParamIDs::numParameters> discrete {};
+
+    Slots editSlots;                          // message thread working copy
+    std::array<Slots, 2> buffers;             // published double buffer
+    std::atomic<int> frontIndex { 0 };
+    std::atomic<int> readingIndex { -1 };
+    std::atomic<juce::uint32> publishedVersion { 0 };
+
+    Slots audioSlots;                         // audio thread private copy
+    juce::uint32 audioVersion = 0;
+
+    JUCE_DECLARE_NON_COPYABLE(SnapshotBank)
+};
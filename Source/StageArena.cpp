@@ -0,0 +1,44 @@
+#include "StageArena.h"
+
+StageArena::StageArena()
+{
+    gate.setLookahead(&lookahead.getLine(LookaheadDelay::gate));
+    compressor.setLookahead(&lookahead.getLine(LookaheadDelay::comp));
+}
+
+void StageArena::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    inputStage.prepare(spec);
+    highPassFilter.prepare(spec);
+    equalizer.prepare(spec);
+    gate.prepare(spec);
+    compressor.prepare(spec);
+    limiter.prepare(spec);
+    ceilingLimiter.prepare(spec);
+    outputStage.prepare(spec);
+    loudnessMatcher.prepare(spec);
+    lookahead.prepare(spec);
+}
+
+void StageArena::reset()
+{
+    inputStage.reset();
+    highPassFilter.reset();
+    equalizer.reset();
+    gate.reset();
+    compressor.reset();
+    limiter.reset();
+    ceilingLimiter.reset();
+    outputStage.reset();
+    loudnessMatcher.reset();
+}
+
+void StageArena::fillChainStages(ProcessingChain::Stages& stages)
+{
+    stages.highPassFilter = &highPassFilter;
+    stages.equalizer = &equalizer;
+    stages.gate = &gate;
+    stages.compressor = &compressor;
+    stages.limiter = &limiter;
+    stages.ceilingLimiter = &ceilingLimiter;
+}
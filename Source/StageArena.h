@@ -0,0 +1,63 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "ProcessingChain.h"
+#include "DSP/InputStage.h"
+#include "DSP/HighPassFilter.h"
+#include "DSP/Equalizer.h"
+#include "DSP/Gate.h"
+#include "DSP/Compressor.h"
+#include "DSP/Limiter.h"
+#include "DSP/OutputStage.h"
+#include "DSP/LoudnessMatcher.h"
+#include "DSP/LookaheadDelay.h"
+
+/**
+ * Stage arena - The Channel Strip
+ *
+ * Every stage the audio thread touches per slice, held by value in one
+ * allocation instead of one heap object each. The processor allocates it in
+ * prepareToPlay, so a session with hundreds of strips gets one contiguous
+ * block per instance, laid out in signal order.
+ *
+ * Each stage starts on its own cache line: the filter and envelope state a
+ * stage reads every sample never shares a line with its neighbour's, and
+ * the hardware prefetcher walks the strip front to back. State only the
+ * offline profile or a settings change reads (oversampling filters, design
+ * parameters) sits behind the hot members or outside the arena entirely.
+ *
+ * Level and loudness meters stay with the processor - the editor reads them
+ * from the message thread before the arena exists.
+ */
+class StageArena
+{
+public:
+    static constexpr size_t kCacheLineSize = 64;
+
+    StageArena();
+
+    void prepare(const juce::dsp::ProcessSpec& spec);
+
+    // Clears the stages' signal state. The lookahead keeps running: the
+    // bypass path still owes the reported latency.
+    void reset();
+
+    // Non-owning view of the reorderable stages for ProcessingChain
+    void fillChainStages(ProcessingChain::Stages& stages);
+
+    alignas(kCacheLineSize) InputStage inputStage;
+    alignas(kCacheLineSize) HighPassFilter highPassFilter;
+    alignas(kCacheLineSize) Equalizer equalizer;
+    alignas(kCacheLineSize) Gate gate;
+    alignas(kCacheLineSize) Compressor compressor;
+    alignas(kCacheLineSize) Limiter limiter;
+    alignas(kCacheLineSize) Limiter ceilingLimiter;
+    alignas(kCacheLineSize) OutputStage outputStage;
+    alignas(kCacheLineSize) LoudnessMatcher loudnessMatcher;
+
+    // One ring buffer behind the gate and compressor lookahead
+    alignas(kCacheLineSize) LookaheadDelay lookahead;
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StageArena)
+};
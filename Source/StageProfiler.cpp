@@ -0,0 +1,96 @@
+#include "StageProfiler.h"
+
+StageProfiler::Stats StageProfiler::getStats(Stage stage) const
+{
+    const auto& data = stages[(size_t) stage];
+    Stats stats;
+
+    const auto totalSamples = data.totalSamples.load(std::memory_order_relaxed);
+    stats.blocks = data.blocks.load(std::memory_order_relaxed);
+
+    if (totalSamples == 0 || stats.blocks == 0)
+        return stats;
+
+    stats.meanNsPerSample = (double) data.totalNs.load(std::memory_order_relaxed) / (double) totalSamples;
+    stats.maxNsPerSample = data.maxNsPerSample.load(std::memory_order_relaxed);
+    stats.budgetFraction = stats.meanNsPerSample * sampleRate.load() * 1.0e-9;
+
+    // p99 from the histogram (upper bin edge, so it never under-reports)
+    juce::uint64 histogramTotal = 0;
+    std::array<juce::uint32, kNumBins> counts {};
+    for (int bin = 0; bin < kNumBins; ++bin)
+    {
+        counts[(size_t) bin] = data.histogram[(size_t) bin].load(std::memory_order_relaxed);
+        histogramTotal += counts[(size_t) bin];
+    }
+
+    const auto target = (juce::uint64) std::ceil(0.99 * (double) histogramTotal);
+    juce::uint64 cumulative = 0;
+    for (int bin = 0; bin < kNumBins; ++bin)
+    {
+        cumulative += counts[(size_t) bin];
+        if (cumulative >= target)
+        {
+            stats.p99NsPerSample = juce::jmin(binUpperEdge(bin), stats.maxNsPerSample);
+            break;
+        }
+    }
+
+    return stats;
+}
+
+void StageProfiler::reset()
+{
+    // Racing with the audio thread only loses a handful of samples - fine for diagnostics
+    for (auto& data : stages)
+    {
+        for (auto& bin : data.histogram)
+            bin.store(0, std::memory_order_relaxed);
+
+        data.totalNs.store(0, std::memory_order_relaxed);
+        data.totalSamples.store(0, std::memory_order_relaxed);
+        data.blocks.store(0, std::memory_order_relaxed);
+        data.maxNsPerSample.store(0.0f, std::memory_order_relaxed);
+    }
+}
+
+bool StageProfiler::dumpToFile(const juce::File& file) const
+{
+    juce::String csv;
+    csv << "# The Channel Strip stage timings, " << juce::Time::getCurrentTime().toString(true, true)
+        << ", " << sampleRate.load() << " Hz\n";
+    csv << "stage,blocks,mean_ns_per_sample,p99_ns_per_sample,max_ns_per_sample,budget_fraction\n";
+
+    for (int i = 0; i < kNumStages; ++i)
+    {
+        const auto stage = static_cast<Stage>(i);
+        const auto stats = getStats(stage);
+
+        csv << getStageName(stage) << ","
+            << (juce::int64) stats.blocks << ","
+            << juce::String(stats.meanNsPerSample, 3) << ","
+            << juce::String(stats.p99NsPerSample, 3) << ","
+            << juce::String(stats.maxNsPerSample, 3) << ","
+            << juce::String(stats.budgetFraction, 6) << "\n";
+    }
+
+    return file.replaceWithText(csv);
+}
+
+const char* StageProfiler::getStageName(Stage stage)
+{
+    switch (stage)
+    {
+        case Stage::input:   return "input";
+        case Stage::hpf:     return "hpf";
+        case Stage::eq:      return "eq";
+        case Stage::gate:    return "gate";
+        case Stage::comp:    return "comp";
+        case Stage::limiter: return "limiter";
+        case Stage::output:  return "output";
+        case Stage::total:   return "total";
+        case Stage::count:   break;
+    }
+
+    return "unknown";
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <chrono>
+
+/**
+ * Per-stage CPU timing - The Channel Strip
+ *
+ * Only compiled when THE_CHANNEL_STRIP_STAGE_TIMING=1 (CMake option of the
+ * same name). With it off, STAGE_TIMING_SCOPE expands to nothing and the
+ * profiler member does not exist, so release builds carry no cost.
+ *
+ * The audio thread records ns/sample for each stage into fixed log-spaced
+ * histograms made of relaxed atomics; the UI thread reads them to derive
+ * mean, p99, max and the fraction of the real-time budget used.
+ */
+class StageProfiler
+{
+public:
+    enum class Stage
+    {
+        input = 0,
+        hpf,
+        eq,
+        gate,
+        comp,
+        limiter,
+        output,
+        total,
+        count
+    };
+
+    static constexpr int kNumStages = static_cast<int>(Stage::count);
+
+    struct Stats
+    {
+        double meanNsPerSample = 0.0;
+        double p99NsPerSample = 0.0;
+        double maxNsPerSample = 0.0;
+        double budgetFraction = 0.0;    // mean cost as a share of one sample period
+        juce::uint64 blocks = 0;
+    };
+
+    class Scope
+    {
+    public:
+        Scope(StageProfiler& p, Stage s, int n)
+            : profiler(p), stage(s), numSamples(n), start(Clock::now()) {}
+
+        ~Scope()
+        {
+            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+            profiler.record(stage, (double) elapsed.count(), numSamples);
+        }
+
+    private:
+        StageProfiler& profiler;
+        Stage stage;
+        int numSamples;
+        std::chrono::steady_clock::time_point start;
+
+        JUCE_DECLARE_NON_COPYABLE(Scope)
+    };
+
+    StageProfiler() = default;
+
+    void prepare(double newSampleRate) { sampleRate.store(newSampleRate); }
+
+    // Audio thread
+    void record(Stage stage, double nanoseconds, int numSamples)
+    {
+        if (numSamples <= 0)
+            return;
+
+        auto& data = stages[(size_t) stage];
+        const double nsPerSample = nanoseconds / numSamples;
+
+        data.histogram[(size_t) binFor(nsPerSample)].fetch_add(1, std::memory_order_relaxed);
+        data.totalNs.fetch_add((juce::uint64) nanoseconds, std::memory_order_relaxed);
+        data.totalSamples.fetch_add((juce::uint64) numSamples, std::memory_order_relaxed);
+        data.blocks.fetch_add(1, std::memory_order_relaxed);
+
+        // Single writer, so load/store is enough for the max
+        if (nsPerSample > data.maxNsPerSample.load(std::memory_order_relaxed))
+            data.maxNsPerSample.store((float) nsPerSample, std::memory_order_relaxed);
+    }
+
+    // Any thread
+    Stats getStats(Stage stage) const;
+    void reset();
+    bool dumpToFile(const juce::File& file) const;
+
+    static const char* getStageName(Stage stage);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Quarter-octave bins from 1/16 ns to 64 us per sample
+    static constexpr int kBinsPerOctave = 4;
+    static constexpr int kMinOctave = -4;
+    static constexpr int kNumBins = 20 * kBinsPerOctave;
+
+    static int binFor(double nsPerSample)
+    {
+        if (nsPerSample <= 0.0)
+            return 0;
+
+        const int bin = (int) std::floor((std::log2(nsPerSample) - kMinOctave) * kBinsPerOctave);
+        return juce::jlimit(0, kNumBins - 1, bin);
+    }
+
+    static double binUpperEdge(int bin)
+    {
+        return std::exp2((double) (bin + 1) / kBinsPerOctave + kMinOctave);
+    }
+
+    struct StageData
+    {
+        std::array<std::atomic<juce::uint32>, kNumBins> histogram {};
+        std::atomic<juce::uint64> totalNs { 0 };
+        std::atomic<juce::uint64> totalSamples { 0 };
+        std::atomic<juce::uint64> blocks { 0 };
+        std::atomic<float> maxNsPerSample { 0.0f };
+    };
+
+    std::array<StageData, kNumStages> stages;
+    std::atomic<double> sampleRate { 44100.0 };
+
+    JUCE_DECLARE_NON_COPYABLE(StageProfiler)
+};
+
+#if THE_CHANNEL_STRIP_STAGE_TIMING
+ #define STAGE_TIMING_SCOPE(profiler, stage, numSamples) \
+    StageProfiler::Scope JUCE_JOIN_MACRO(stageTimingScope_, __LINE__) (profiler, StageProfiler::Stage::stage, numSamples)
+#else
+ #define STAGE_TIMING_SCOPE(profiler, stage, numSamples)
+#endif
@@ -0,0 +1,234 @@
+#include "StateSerializer.h"
+
+namespace
+{
+    constexpr juce::uint32 kMagic = 0x42545343; // "CSTB" read little-endian
+    constexpr int kHeaderSize = 8;              // magic + version + count
+    constexpr int kRecordSize = 6;              // key + value
+
+    // ==============================================================================
+    // Migrations - kMigrations[v] upgrades a state from version v to v + 1
+    // ==============================================================================
+    using Migration = void (*)(StateSerializer::LoadedState&);
+
+    // v0: XML written before stateVersion existed. Same parameters as v1.
+    void migrateV0ToV1(StateSerializer::LoadedState&) {}
+
+    // v1 -> v2: only the container changed (XML -> binary records).
+    void migrateV1ToV2(StateSerializer::LoadedState&) {}
+
+    // v2 -> v3: A/B snapshots added. Older sessions start with every slot
+    // holding the saved settings, so comparing is a no-op until a slot is stored.
+    void migrateV2ToV3(StateSerializer::LoadedState& state)
+    {
+        state.snapshots.fill(state.parameters);
+    }
+
+    constexpr Migration kMigrations[] = {
+        migrateV0ToV1,
+        migrateV1ToV2,
+        migrateV2ToV3,
+    };
+
+    static_assert(std::size(kMigrations) == StateSerializer::kStateVersion,
+                  "Every state version needs a migration to the next one");
+
+    void writeRecords(juce::MemoryOutputStream& out, const ParameterSet& values)
+    {
+        out.writeShort((short) ParamIDs::numParameters);
+
+        for (int i = 0; i < ParamIDs::numParameters; ++i)
+        {
+            out.writeShort((short) i);
+            out.writeFloat(values.values[(size_t) i]);
+        }
+    }
+
+    bool readRecords(juce::MemoryInputStream& in, StateSerializer::Values& out)
+    {
+        if (in.getNumBytesRemaining() < 2)
+            return false;
+
+        const int numRecords = (int) (juce::uint16) in.readShort();
+
+        if (in.getNumBytesRemaining() < (juce::int64) numRecords * kRecordSize)
+            return false;
+
+        for (int i = 0; i < numRecords; ++i)
+        {
+            const int key = (int) (juce::uint16) in.readShort();
+            const float value = in.readFloat();
+
+            // Keys from newer versions are ignored
+            if (key < ParamIDs::numParameters)
+            {
+                out.values[(size_t) key] = value;
+                out.present[(size_t) key] = true;
+            }
+        }
+
+        return true;
+    }
+}
+
+StateSerializer::StateSerializer(juce::AudioProcessorValueTreeState& apvts, SnapshotBank& snapshots)
+    : snapshotBank(snapshots)
+{
+    for (int i = 0; i < ParamIDs::numParameters; ++i)
+    {
+        parameters[(size_t) i] = apvts.getParameter(ParamIDs::all[i]);
+        jassert(parameters[(size_t) i] != nullptr);
+    }
+}
+
+void StateSerializer::save(juce::MemoryBlock& destData) const
+{
+    constexpr int recordsSize = 2 + kRecordSize * ParamIDs::numParameters;
+
+    destData.setSize(0);
+    destData.ensureSize(6 + recordsSize * (1 + SnapshotBank::kNumSlots) + 2);
+
+    ParameterSet current;
+    for (int i = 0; i < ParamIDs::numParameters; ++i)
+    {
+        auto* param = parameters[(size_t) i];
+        current.values[(size_t) i] = param->convertFrom0to1(param->getValue());
+    }
+
+    juce::MemoryOutputStream out(destData, false);
+    out.writeInt((int) kMagic);
+    out.writeShort((short) kStateVersion);
+    writeRecords(out, current);
+
+    out.writeShort((short) SnapshotBank::kNumSlots);
+    for (int slot = 0; slot < SnapshotBank::kNumSlots; ++slot)
+        writeRecords(out, snapshotBank.get(slot));
+}
+
+bool StateSerializer::load(const void* data, int sizeInBytes)
+{
+    LoadedState state;
+    if (!parse(data, sizeInBytes, state))
+        return false;
+
+    apply(state);
+    return true;
+}
+
+bool StateSerializer::parse(const void* data, int sizeInBytes, LoadedState& out)
+{
+    const bool parsed = parseBinary(data, sizeInBytes, out)
+                     || parseLegacyXml(data, sizeInBytes, out);
+
+    if (parsed)
+        migrate(out);
+
+    return parsed;
+}
+
+void StateSerializer::migrate(LoadedState& state)
+{
+    if (state.version > kStateVersion)
+    {
+        DBG("State from a newer version (" << state.version << "), loading known parameters only");
+        return;
+    }
+
+    while (state.version < kStateVersion)
+    {
+        kMigrations[state.version](state);
+        ++state.version;
+    }
+}
+
+bool StateSerializer::parseBinary(const void* data, int sizeInBytes, LoadedState& out)
+{
+    if (data == nullptr || sizeInBytes < kHeaderSize
+        || juce::ByteOrder::littleEndianInt(data) != kMagic)
+        return false;
+
+    juce::MemoryInputStream in(data, (size_t) sizeInBytes, false);
+    in.skipNextBytes(4);
+
+    out.version = (int) (juce::uint16) in.readShort();
+
+    if (!readRecords(in, out.parameters))
+        return false;
+
+    if (out.version >= 3 && in.getNumBytesRemaining() >= 2)
+    {
+        const int numSlots = (int) (juce::uint16) in.readShort();
+
+        for (int slot = 0; slot < numSlots; ++slot)
+        {
+            Values values;
+            if (!readRecords(in, values))
+                break;
+
+            if (slot < SnapshotBank::kNumSlots)
+                out.snapshots[(size_t) slot] = values;
+        }
+    }
+
+    return true;
+}
+
+bool StateSerializer::parseLegacyXml(const void* data, int sizeInBytes, LoadedState& out)
+{
+    std::unique_ptr<juce::XmlElement> xml(juce::AudioProcessor::getXmlFromBinary(data, sizeInBytes));
+
+    if (xml == nullptr || !xml->hasTagName("Parameters"))
+        return false;
+
+    out.version = xml->getIntAttribute("stateVersion", 0);
+
+    // The version indexes the migration table, so a corrupt or hostile
+    // state with a negative one is rejected rather than read out of bounds
+    if (out.version < 0)
+        return false;
+
+    for (auto* element : xml->getChildWithTagNameIterator("PARAM"))
+    {
+        const auto id = element->getStringAttribute("id");
+
+        for (int i = 0; i < ParamIDs::numParameters; ++i)
+        {
+            if (id == ParamIDs::all[i])
+            {
+                out.parameters.values[(size_t) i] = (float) element->getDoubleAttribute("value");
+                out.parameters.present[(size_t) i] = true;
+                break;
+            }
+        }
+    }
+
+    return true;
+}
+
+void StateSerializer::apply(const LoadedState& state)
+{
+    SnapshotBank::Slots slots;
+
+    for (int i = 0; i < ParamIDs::numParameters; ++i)
+    {
+        const auto idx = (size_t) i;
+        auto* param = parameters[idx];
+        const float defaultValue = param->convertFrom0to1(param->getDefaultValue());
+
+        const float value = state.parameters.present[idx] ? state.parameters.values[idx] : defaultValue;
+        const float normalised = param->convertTo0to1(value);
+
+        // Only touch parameters that actually change - this is what keeps
+        // listener/host fan-out low when a session recalls many instances
+        if (std::abs(param->getValue() - normalised) > 1.0e-6f)
+            param->setValueNotifyingHost(normalised);
+
+        for (size_t slot = 0; slot < slots.size(); ++slot)
+        {
+            const auto& snapshot = state.snapshots[slot];
+            slots[slot].values[idx] = snapshot.present[idx] ? snapshot.values[idx] : defaultValue;
+        }
+    }
+
+    snapshotBank.storeAll(slots);
+}
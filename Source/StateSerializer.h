@@ -0,0 +1,61 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "ParameterIDs.h"
+#include "SnapshotBank.h"
+
+/**
+ * Binary plugin state - The Channel Strip
+ *
+ * Layout (little-endian):
+ *   uint32  magic 'CSTB'
+ *   uint16  state version (kStateVersion)
+ *   uint16  record count
+ *   count x { uint16 ParamIDs::Index, float32 denormalised value }
+ *   uint16  snapshot slot count                          (v3+)
+ *   per slot: uint16 record count, records as above      (v3+)
+ *
+ * Values are stored in real units (dB, Hz, ms...) so a range change between
+ * versions can be handled by a migration. Unknown keys are skipped and missing
+ * keys fall back to the parameter default.
+ *
+ * States written by 1.0 (XML via copyXmlToBinary) are still readable.
+ */
+class StateSerializer
+{
+public:
+    static constexpr int kStateVersion = 3;
+
+    struct Values
+    {
+        std::array<float, ParamIDs::numParameters> values {};
+        std::array<bool, ParamIDs::numParameters> present {};
+    };
+
+    struct LoadedState
+    {
+        int version = 0;
+        Values parameters;
+        std::array<Values, SnapshotBank::kNumSlots> snapshots;
+    };
+
+    StateSerializer(juce::AudioProcessorValueTreeState& apvts, SnapshotBank& snapshots);
+
+    void save(juce::MemoryBlock& destData) const;
+    bool load(const void* data, int sizeInBytes);
+
+    // Parses either format and migrates it up to kStateVersion
+    static bool parse(const void* data, int sizeInBytes, LoadedState& out);
+    static void migrate(LoadedState& state);
+
+private:
+    static bool parseBinary(const void* data, int sizeInBytes, LoadedState& out);
+    static bool parseLegacyXml(const void* data, int sizeInBytes, LoadedState& out);
+
+    void apply(const LoadedState& state);
+
+    SnapshotBank& snapshotBank;
+    std::array<juce::RangedAudioParameter*, ParamIDs::numParameters> parameters {};
+
+    JUCE_DECLARE_NON_COPYABLE(StateSerializer)
+};
@@ -0,0 +1,82 @@
+#include "TransferCurves.h"
+#include "ParameterIDs.h"
+#include "DSP/Compressor.h"
+#include "DSP/Gate.h"
+#include <limits>
+
+namespace
+{
+    float load(juce::AudioProcessorValueTreeState& apvts, const char* id)
+    {
+        return apvts.getRawParameterValue(id)->load();
+    }
+}
+
+TransferCurves::TransferCurves(juce::AudioProcessorValueTreeState& state)
+    : apvts(state)
+{
+    compSettings.fill(std::numeric_limits<float>::quiet_NaN());
+    gateSettings.fill(std::numeric_limits<float>::quiet_NaN());
+}
+
+float TransferCurves::inputDbAt(int index)
+{
+    return kMinDb + (kMaxDb - kMinDb) * (float) index / (float) (kNumPoints - 1);
+}
+
+bool TransferCurves::update()
+{
+    bool changed = false;
+
+    const std::array<float, 3> comp { load(apvts, ParamIDs::compThreshold),
+                                      load(apvts, ParamIDs::compRatio),
+                                      load(apvts, ParamIDs::compKnee) };
+
+    if (comp != compSettings)
+    {
+        compSettings = comp;
+        for (int i = 0; i < kNumPoints; ++i)
+        {
+            const float input = inputDbAt(i);
+            compCurve[(size_t) i] = input + Compressor::computeStaticGain(input, comp[0], comp[1], comp[2]);
+        }
+        changed = true;
+    }
+
+    const std::array<float, 3> gate { load(apvts, ParamIDs::gateThreshold),
+                                      load(apvts, ParamIDs::gateRange),
+                                      load(apvts, ParamIDs::gateHysteresis) };
+
+    if (gate != gateSettings)
+    {
+        gateSettings = gate;
+        for (int i = 0; i < kNumPoints; ++i)
+        {
+            const float input = inputDbAt(i);
+            gateCurve[(size_t) i] = input + Gate::computeStaticGain(input, gate[0], gate[1], gate[2], false);
+            gateCloseCurve[(size_t) i] = input + Gate::computeStaticGain(input, gate[0], gate[1], gate[2], true);
+        }
+        changed = true;
+    }
+
+    return changed;
+}
+
+juce::var TransferCurves::toVar() const
+{
+    const auto toArray = [](const Curve& curve) {
+        juce::Array<juce::var> points;
+        points.ensureStorageAllocated(kNumPoints);
+        for (const float value : curve)
+            points.add(value);
+        return juce::var(points);
+    };
+
+    juce::DynamicObject::Ptr data = new juce::DynamicObject();
+    data->setProperty("minDb", kMinDb);
+    data->setProperty("maxDb", kMaxDb);
+    data->setProperty("comp", toArray(compCurve));
+    data->setProperty("gate", toArray(gateCurve));
+    data->setProperty("gateClose", toArray(gateCloseCurve));
+    return juce::var(data.get());
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <array>
+
+/**
+ * Transfer curves - The Channel Strip
+ *
+ * Static input/output curves of the compressor and gate for the UI, sampled
+ * from the DSP classes' own computeStaticGain() so the web view never
+ * reimplements them. Lives on the message thread: update() re-reads the
+ * curve parameters and only recomputes a curve when one of them moved.
+ */
+class TransferCurves
+{
+public:
+    static constexpr int kNumPoints = 256;
+    static constexpr float kMinDb = -80.0f;
+    static constexpr float kMaxDb = 0.0f;
+
+    explicit TransferCurves(juce::AudioProcessorValueTreeState& state);
+
+    // True if either curve changed since the last call
+    bool update();
+
+    // { minDb, maxDb, comp: [output dB...], gate: [...], gateClose: [...] } -
+    // input levels are kNumPoints evenly spaced steps from minDb to maxDb.
+    // gate is the opening curve, gateClose the curve of an already open gate.
+    juce::var toVar() const;
+
+private:
+    using Curve = std::array<float, kNumPoints>;
+
+    static float inputDbAt(int index);
+
+    juce::AudioProcessorValueTreeState& apvts;
+
+    Curve compCurve {}, gateCurve {}, gateCloseCurve {};
+
+    // Parameter values the curves were computed for (NaN forces the first update)
+    std::array<float, 3> compSettings;
+    std::array<float, 3> gateSettings;
+};
@@ -0,0 +1,82 @@
+#include "WebParameterBindings.h"
+#include "ParameterTable.h"
+
+using ParameterTable::Kind;
+
+WebParameterBindings::WebParameterBindings()
+{
+    sliderRelays.reserve((size_t) ParameterTable::countOf(Kind::slider));
+    toggleRelays.reserve((size_t) ParameterTable::countOf(Kind::toggle));
+    comboBoxRelays.reserve((size_t) ParameterTable::countOf(Kind::choice));
+
+    // Relay names are the parameter IDs the page asks for
+    for (const auto& d : ParameterTable::descriptors)
+    {
+        switch (d.kind)
+        {
+            case Kind::slider: sliderRelays.push_back(std::make_unique<juce::WebSliderRelay>(d.getID())); break;
+            case Kind::toggle: toggleRelays.push_back(std::make_unique<juce::WebToggleButtonRelay>(d.getID())); break;
+            case Kind::choice: comboBoxRelays.push_back(std::make_unique<juce::WebComboBoxRelay>(d.getID())); break;
+        }
+    }
+}
+
+juce::WebBrowserComponent::Options WebParameterBindings::addTo(juce::WebBrowserComponent::Options options)
+{
+    for (auto& relay : sliderRelays)
+        options = options.withOptionsFrom(*relay);
+    for (auto& relay : toggleRelays)
+        options = options.withOptionsFrom(*relay);
+    for (auto& relay : comboBoxRelays)
+        options = options.withOptionsFrom(*relay);
+
+    return options;
+}
+
+void WebParameterBindings::attach(juce::AudioProcessorValueTreeState& apvts)
+{
+    detach();
+
+    sliderAttachments.reserve(sliderRelays.size());
+    toggleAttachments.reserve(toggleRelays.size());
+    comboBoxAttachments.reserve(comboBoxRelays.size());
+
+    // Relays were created in table order within each kind
+    size_t slider = 0, toggle = 0, comboBox = 0;
+
+    for (const auto& d : ParameterTable::descriptors)
+    {
+        auto* param = apvts.getParameter(d.getID());
+        jassert(param != nullptr);
+
+        switch (d.kind)
+        {
+            case Kind::slider:
+                sliderAttachments.push_back(std::make_unique<juce::WebSliderParameterAttachment>(
+                    *param, *sliderRelays[slider++], nullptr));
+                break;
+
+            case Kind::toggle:
+                toggleAttachments.push_back(std::make_unique<juce::WebToggleButtonParameterAttachment>(
+                    *param, *toggleRelays[toggle++], nullptr));
+                break;
+
+            case Kind::choice:
+                comboBoxAttachments.push_back(std::make_unique<juce::WebComboBoxParameterAttachment>(
+                    *param, *comboBoxRelays[comboBox++], nullptr));
+                break;
+        }
+    }
+}
+
+void WebParameterBindings::detach()
+{
+    sliderAttachments.clear();
+    toggleAttachments.clear();
+    comboBoxAttachments.clear();
+}
+
+int WebParameterBindings::getNumRelays() const
+{
+    return (int) (sliderRelays.size() + toggleRelays.size() + comboBoxRelays.size());
+}
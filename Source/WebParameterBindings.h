@@ -0,0 +1,43 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_gui_extra/juce_gui_extra.h>
+#include <memory>
+#include <vector>
+
+/**
+ * Web parameter bindings - The Channel Strip
+ *
+ * One web relay and one parameter attachment per ParameterTable entry,
+ * generated from the table instead of declared by hand. Relays are grouped
+ * by kind in storage reserved up front and created in one pass, then
+ * registered with the browser options in one pass.
+ *
+ * Order matters (see TheChannelStripEditor): construct before the
+ * WebBrowserComponent, addTo() its options, attach() once it exists and
+ * detach() before it is destroyed.
+ */
+class WebParameterBindings
+{
+public:
+    WebParameterBindings();
+
+    // Registers every relay with the browser options
+    juce::WebBrowserComponent::Options addTo(juce::WebBrowserComponent::Options options);
+
+    void attach(juce::AudioProcessorValueTreeState& apvts);
+    void detach();
+
+    int getNumRelays() const;
+
+private:
+    std::vector<std::unique_ptr<juce::WebSliderRelay>> sliderRelays;
+    std::vector<std::unique_ptr<juce::WebToggleButtonRelay>> toggleRelays;
+    std::vector<std::unique_ptr<juce::WebComboBoxRelay>> comboBoxRelays;
+
+    std::vector<std::unique_ptr<juce::WebSliderParameterAttachment>> sliderAttachments;
+    std::vector<std::unique_ptr<juce::WebToggleButtonParameterAttachment>> toggleAttachments;
+    std::vector<std::unique_ptr<juce::WebComboBoxParameterAttachment>> comboBoxAttachments;
+
+    JUCE_DECLARE_NON_COPYABLE(WebParameterBindings)
+};
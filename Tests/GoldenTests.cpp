@@ -0,0 +1,539 @@
+#include "Test.h"
+#include "TestSignals.h"
+#include "PluginProcessor.h"
+#include "ParameterIDs.h"
+#include "ParameterSet.h"
+#include "DSP/InputStage.h"
+#include "DSP/HighPassFilter.h"
+#include "DSP/Equalizer.h"
+#include "DSP/Gate.h"
+#include "DSP/Compressor.h"
+#include "DSP/Limiter.h"
+#include "DSP/OutputStage.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+
+/**
+ * Golden-output regression tests
+ *
+ * Renders every TestSignals signal through each DSP stage on its own and
+ * through the full processor at several presets, then compares against the
+ * reference WAVs (32-bit float) in Tests/Golden. One file per case/preset
+ * holds all signals back to back.
+ *
+ * Recording references: build TheChannelStripRecordGolden (or run with
+ * THE_CHANNEL_STRIP_UPDATE_GOLDEN=1) and commit Tests/Golden. Only do this
+ * when an output change is intended. A missing reference fails like a
+ * mismatch, so a case can't pass without being compared.
+ */
+namespace
+{
+    using P = ParamIDs::Index;
+
+    constexpr double kSampleRate = 48000.0;
+    constexpr int kBlockSize = 256;
+
+    // ==============================================================================
+    // Presets (real units; anything not listed stays at its default)
+    // ==============================================================================
+    struct Preset
+    {
+        const char* name;
+        std::vector<std::pair<P, float>> values;
+    };
+
+    const std::vector<Preset>& presets()
+    {
+        static const std::vector<Preset> all {
+            { "neutral", {} },
+            { "vocal", {
+                { P::hpfEnabled, 1.0f }, { P::hpfFreq, 100.0f }, { P::hpfSlope, 2.0f },
+                { P::eqLowGain, -2.0f }, { P::eqLowFreq, 200.0f },
+                { P::eqLowMidGain, -3.0f }, { P::eqLowMidFreq, 350.0f }, { P::eqLowMidQ, 1.4f },
+                { P::eqHighMidGain, 3.0f }, { P::eqHighMidFreq, 3500.0f }, { P::eqHighMidQ, 0.8f },
+                { P::eqHighGain, 4.0f }, { P::eqHighFreq, 12000.0f },
+                { P::compEnabled, 1.0f }, { P::compThreshold, -24.0f }, { P::compRatio, 3.0f },
+                { P::compAttack, 5.0f }, { P::compRelease, 80.0f }, { P::compMakeup, 4.0f },
+                { P::limiterEnabled, 1.0f }, { P::limiterCeiling, -1.0f }, { P::limiterRelease, 50.0f },
+                { P::outputWidth, 110.0f } } },
+            { "drum bus", {
+                { P::inputGain, 6.0f },
+                { P::eqLowGain, 4.0f }, { P::eqLowFreq, 60.0f }, { P::eqLowShelf, 0.0f },
+                { P::eqHighGain, 3.0f }, { P::eqHighFreq, 8000.0f },
+                { P::gateEnabled, 1.0f }, { P::gateThreshold, -35.0f }, { P::gateAttack, 0.5f },
+                { P::gateRelease, 80.0f }, { P::gateRange, -30.0f },
+                { P::compEnabled, 1.0f }, { P::compThreshold, -18.0f }, { P::compRatio, 6.0f },
+                { P::compAttack, 1.0f }, { P::compRelease, 50.0f }, { P::compMakeup, 6.0f }, { P::compKnee, 2.0f },
+                { P::limiterEnabled, 1.0f }, { P::limiterCeiling, -0.3f }, { P::limiterRelease, 20.0f },
+                { P::outputWidth, 130.0f } } },
+            { "extreme", {
+                { P::inputGain, 24.0f }, { P::inputPhase, 1.0f }, { P::inputPad, 1.0f },
+                { P::hpfEnabled, 1.0f }, { P::hpfFreq, 500.0f }, { P::hpfSlope, 0.0f },
+                { P::eqLowGain, 18.0f }, { P::eqLowFreq, 500.0f }, { P::eqLowShelf, 0.0f },
+                { P::eqLowMidGain, -18.0f }, { P::eqLowMidFreq, 1000.0f }, { P::eqLowMidQ, 10.0f },
+                { P::eqHighMidGain, 18.0f }, { P::eqHighMidFreq, 4000.0f }, { P::eqHighMidQ, 0.1f },
+                { P::eqHighGain, -18.0f }, { P::eqHighFreq, 20000.0f }, { P::eqHighShelf, 0.0f },
+                { P::gateEnabled, 1.0f }, { P::gateThreshold, -20.0f }, { P::gateAttack, 0.1f },
+                { P::gateRelease, 10.0f }, { P::gateRange, -80.0f },
+                { P::compEnabled, 1.0f }, { P::compThreshold, -60.0f }, { P::compRatio, 20.0f },
+                { P::compAttack, 0.1f }, { P::compRelease, 10.0f }, { P::compMakeup, 24.0f }, { P::compKnee, 0.0f },
+                { P::limiterEnabled, 1.0f }, { P::limiterCeiling, -12.0f }, { P::limiterRelease, 10.0f },
+                { P::outputGain, -24.0f }, { P::outputWidth, 200.0f } } },
+            // Gate > HPF > Comp > EQ: the gate keys on the unfiltered signal and
+            // the EQ boost lands after the compressor instead of driving it
+            { "routing", {
+                { P::hpfEnabled, 1.0f }, { P::hpfFreq, 150.0f }, { P::hpfSlope, 1.0f },
+                { P::eqLowGain, 6.0f }, { P::eqLowFreq, 120.0f },
+                { P::eqHighMidGain, 6.0f }, { P::eqHighMidFreq, 2500.0f }, { P::eqHighMidQ, 1.0f },
+                { P::gateEnabled, 1.0f }, { P::gateThreshold, -40.0f }, { P::gateRange, -30.0f },
+                { P::compEnabled, 1.0f }, { P::compThreshold, -20.0f }, { P::compRatio, 4.0f },
+                { P::limiterEnabled, 1.0f }, { P::limiterCeiling, -1.0f },
+                { P::stageOrder, 3.0f } } },
+            // M/S EQ into a mid-only compressor, then an L/R limiter: encode in
+            // InputStage, one decode inside the chain, plain OutputStage
+            { "mid side", {
+                { P::eqLowGain, -3.0f }, { P::eqHighGain, 4.0f }, { P::eqHighFreq, 6000.0f },
+                { P::compEnabled, 1.0f }, { P::compThreshold, -24.0f }, { P::compRatio, 4.0f },
+                { P::limiterEnabled, 1.0f }, { P::limiterCeiling, -1.0f },
+                { P::outputWidth, 150.0f },
+                { P::eqMode, 3.0f }, { P::compMode, 1.0f } } },
+            // Tube drive ahead of an M/S EQ: the saturation runs before the
+            // mid/side matrix, which then costs its own pass
+            { "tube drive", {
+                { P::inputDrive, 12.0f }, { P::inputSaturation, 2.0f },
+                { P::eqLowGain, 2.0f }, { P::eqMode, 3.0f },
+                { P::limiterEnabled, 1.0f }, { P::limiterCeiling, -1.0f } } },
+            // Lookahead gate with hold and hysteresis into a lookahead compressor on the mid
+            // channel only: both lanes of the shared delay line, plus the side pass-through
+            { "lookahead", {
+                { P::gateEnabled, 1.0f }, { P::gateThreshold, -30.0f }, { P::gateRange, -40.0f },
+                { P::gateHold, 50.0f }, { P::gateHysteresis, 6.0f }, { P::gateLookahead, 2.0f },
+                { P::compEnabled, 1.0f }, { P::compThreshold, -20.0f }, { P::compRatio, 4.0f },
+                { P::compLookahead, 5.0f }, { P::compMode, 1.0f } } },
+            // Unlinked gate, half-linked compressor and unlinked limiter: one
+            // envelope per channel in every dynamics stage
+            { "unlinked", {
+                { P::gateEnabled, 1.0f }, { P::gateThreshold, -30.0f }, { P::gateRange, -40.0f }, { P::gateLink, 0.0f },
+                { P::compEnabled, 1.0f }, { P::compThreshold, -24.0f }, { P::compRatio, 4.0f }, { P::compLink, 50.0f },
+                { P::limiterEnabled, 1.0f }, { P::limiterCeiling, -3.0f }, { P::limiterLink, 0.0f } } }
+        };
+
+        return all;
+    }
+
+    // Builds the preset with every value snapped to its parameter range, the
+    // same values the processor sees when the preset is applied through the APVTS
+    ParameterSet makeParameters(const Preset& preset)
+    {
+        TheChannelStripProcessor processor;
+        ParameterSet params;
+
+        for (int i = 0; i < ParamIDs::numParameters; ++i)
+        {
+            auto* param = processor.getAPVTS().getParameter(ParamIDs::all[i]);
+            params.values[(size_t) i] = param->convertFrom0to1(param->getDefaultValue());
+        }
+
+        for (const auto& [index, value] : preset.values)
+        {
+            auto* param = processor.getAPVTS().getParameter(ParamIDs::idFor(index));
+            params[index] = param->convertFrom0to1(param->convertTo0to1(value));
+        }
+
+        return params;
+    }
+
+    // ==============================================================================
+    // Rendering
+    // ==============================================================================
+    enum class Case { input, hpf, eq, gate, comp, limiter, output, chain };
+
+    struct CaseInfo
+    {
+        Case id;
+        const char* name;
+        float tolerance;    // max absolute sample error
+    };
+
+    // Tight enough to catch any algorithm change, loose enough for reordered
+    // float arithmetic (vectorisation, FMA contraction). The filters get none:
+    // the inline Biquad repeats IIR::Filter's arithmetic operation for operation
+    // (see biquadMatchesFilter), so any difference there is a real change.
+    constexpr CaseInfo kCases[] = {
+        { Case::input,   "input",   1.0e-6f },
+        { Case::hpf,     "hpf",     0.0f },
+        { Case::eq,      "eq",      0.0f },
+        { Case::gate,    "gate",    1.0e-5f },
+        { Case::comp,    "comp",    2.0e-5f },
+        { Case::limiter, "limiter", 1.0e-5f },
+        { Case::output,  "output",  1.0e-6f },
+        { Case::chain,   "chain",   1.0e-4f }
+    };
+
+    // Runs `configure` then `process` for every kBlockSize slice, like processBlock does
+    template <typename Stage, typename Configure>
+    void renderStage(Stage& stage, juce::AudioBuffer<float>& buffer, Configure&& configure)
+    {
+        juce::dsp::ProcessSpec spec { kSampleRate, (juce::uint32) kBlockSize, (juce::uint32) buffer.getNumChannels() };
+        stage.prepare(spec);
+
+        juce::dsp::AudioBlock<float> whole(buffer);
+        for (int start = 0; start < buffer.getNumSamples(); start += kBlockSize)
+        {
+            const int length = juce::jmin(kBlockSize, buffer.getNumSamples() - start);
+            auto block = whole.getSubBlock((size_t) start, (size_t) length);
+            juce::dsp::ProcessContextReplacing<float> context(block);
+
+            configure(stage);
+            stage.process(context);
+        }
+    }
+
+    void renderChain(const Preset& preset, juce::AudioBuffer<float>& buffer)
+    {
+        TheChannelStripProcessor processor;
+
+        for (const auto& [index, value] : preset.values)
+        {
+            auto* param = processor.getAPVTS().getParameter(ParamIDs::idFor(index));
+            param->setValueNotifyingHost(param->convertTo0to1(value));
+        }
+
+        processor.setRateAndBufferSizeDetails(kSampleRate, kBlockSize);
+        processor.prepareToPlay(kSampleRate, kBlockSize);
+
+        juce::MidiBuffer midi;
+        for (int start = 0; start < buffer.getNumSamples(); start += kBlockSize)
+        {
+            const int length = juce::jmin(kBlockSize, buffer.getNumSamples() - start);
+            juce::AudioBuffer<float> slice(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, length);
+            processor.processBlock(slice, midi);
+        }
+
+        processor.releaseResources();
+    }
+
+    void render(Case id, const Preset& preset, juce::AudioBuffer<float>& buffer)
+    {
+        const auto p = makeParameters(preset);
+
+        switch (id)
+        {
+            case Case::input:
+            {
+                InputStage stage;
+                renderStage(stage, buffer, [&](InputStage& s) {
+                    s.setGain(p[P::inputGain]);
+                    s.setPhaseInvert(p.isOn(P::inputPhase));
+                    s.setPad(p.isOn(P::inputPad));
+                });
+                break;
+            }
+            case Case::hpf:
+            {
+                HighPassFilter stage;
+                renderStage(stage, buffer, [&](HighPassFilter& s) {
+                    s.setFrequency(p[P::hpfFreq]);
+                    s.setSlope(static_cast<int>(p[P::hpfSlope]));
+                });
+                break;
+            }
+            case Case::eq:
+            {
+                Equalizer stage;
+                renderStage(stage, buffer, [&](Equalizer& s) {
+                    s.setLowBand(p[P::eqLowGain], p[P::eqLowFreq], p.isOn(P::eqLowShelf));
+                    s.setLowMidBand(p[P::eqLowMidGain], p[P::eqLowMidFreq], p[P::eqLowMidQ]);
+                    s.setHighMidBand(p[P::eqHighMidGain], p[P::eqHighMidFreq], p[P::eqHighMidQ]);
+                    s.setHighBand(p[P::eqHighGain], p[P::eqHighFreq], p.isOn(P::eqHighShelf));
+                });
+                break;
+            }
+            case Case::gate:
+            {
+                Gate stage;
+                renderStage(stage, buffer, [&](Gate& s) {
+                    s.setThreshold(p[P::gateThreshold]);
+                    s.setAttack(p[P::gateAttack]);
+                    s.setRelease(p[P::gateRelease]);
+                    s.setRange(p[P::gateRange]);
+                    s.setStereoLink(p[P::gateLink]);
+                });
+                break;
+            }
+            case Case::comp:
+            {
+                Compressor stage;
+                renderStage(stage, buffer, [&](Compressor& s) {
+                    s.setThreshold(p[P::compThreshold]);
+                    s.setRatio(p[P::compRatio]);
+                    s.setAttack(p[P::compAttack]);
+                    s.setRelease(p[P::compRelease]);
+                    s.setMakeup(p[P::compMakeup]);
+                    s.setKnee(p[P::compKnee]);
+                    s.setStereoLink(p[P::compLink]);
+                });
+                break;
+            }
+            case Case::limiter:
+            {
+                Limiter stage;
+                renderStage(stage, buffer, [&](Limiter& s) {
+                    s.setCeiling(p[P::limiterCeiling]);
+                    s.setRelease(p[P::limiterRelease]);
+                    s.setStereoLink(p[P::limiterLink]);
+                });
+                break;
+            }
+            case Case::output:
+            {
+                OutputStage stage;
+                renderStage(stage, buffer, [&](OutputStage& s) {
+                    s.setGain(p[P::outputGain]);
+                    s.setWidth(p[P::outputWidth]);
+                });
+                break;
+            }
+            case Case::chain:
+                renderChain(preset, buffer);
+                break;
+        }
+    }
+
+    // All signals rendered separately (fresh state each) and laid end to end
+    juce::AudioBuffer<float> renderAll(Case id, const Preset& preset, std::vector<int>& segmentStarts)
+    {
+        std::vector<juce::AudioBuffer<float>> outputs;
+        int total = 0;
+
+        for (const auto& signal : TestSignals::all())
+        {
+            outputs.push_back(signal.make(kSampleRate));
+            render(id, preset, outputs.back());
+            segmentStarts.push_back(total);
+            total += outputs.back().getNumSamples();
+        }
+
+        juce::AudioBuffer<float> result(2, total);
+        for (size_t i = 0; i < outputs.size(); ++i)
+            for (int ch = 0; ch < 2; ++ch)
+                result.copyFrom(ch, segmentStarts[i], outputs[i], ch, 0, outputs[i].getNumSamples());
+
+        return result;
+    }
+
+    // ==============================================================================
+    // Reference files
+    // ==============================================================================
+    juce::File getGoldenDirectory()
+    {
+        const auto overridden = juce::SystemStats::getEnvironmentVariable("THE_CHANNEL_STRIP_GOLDEN_DIR", {});
+        return juce::File(overridden.isNotEmpty() ? overridden : juce::String(THE_CHANNEL_STRIP_GOLDEN_DIR));
+    }
+
+    juce::File getReferenceFile(const CaseInfo& info, const Preset& preset)
+    {
+        const auto name = juce::String(info.name) + "_" + juce::String(preset.name).replaceCharacter(' ', '-');
+        return getGoldenDirectory().getChildFile(name + ".wav");
+    }
+
+    bool writeReference(const juce::File& file, const juce::AudioBuffer<float>& buffer)
+    {
+        file.getParentDirectory().createDirectory();
+        file.deleteFile();
+
+        auto stream = std::make_unique<juce::FileOutputStream>(file);
+        if (!stream->openedOk())
+            return false;
+
+        // 32 bits -> IEEE float WAV, so the reference round-trips exactly
+        std::unique_ptr<juce::AudioFormatWriter> writer(juce::WavAudioFormat().createWriterFor(
+            stream.get(), kSampleRate, (unsigned int) buffer.getNumChannels(), 32, {}, 0));
+
+        if (writer == nullptr)
+            return false;
+
+        stream.release();
+        return writer->writeFromAudioSampleBuffer(buffer, 0, buffer.getNumSamples());
+    }
+
+    bool readReference(const juce::File& file, juce::AudioBuffer<float>& buffer)
+    {
+        std::unique_ptr<juce::AudioFormatReader> reader(
+            juce::WavAudioFormat().createReaderFor(new juce::FileInputStream(file), true));
+
+        if (reader == nullptr)
+            return false;
+
+        buffer.setSize((int) reader->numChannels, (int) reader->lengthInSamples);
+        return reader->read(&buffer, 0, buffer.getNumSamples(), 0, true, true);
+    }
+
+    // ==============================================================================
+    // Comparison
+    // ==============================================================================
+    struct Difference
+    {
+        float maxError = 0.0f;
+        double nullDepthDb = -200.0;    // residual energy relative to the reference
+    };
+
+    Difference compare(const juce::AudioBuffer<float>& actual, const juce::AudioBuffer<float>& reference, int start, int length)
+    {
+        Difference difference;
+        double errorEnergy = 0.0, referenceEnergy = 0.0;
+
+        for (int ch = 0; ch < actual.getNumChannels(); ++ch)
+        {
+            const float* a = actual.getReadPointer(ch, start);
+            const float* r = reference.getReadPointer(ch, start);
+
+            for (int i = 0; i < length; ++i)
+            {
+                const float error = a[i] - r[i];
+                difference.maxError = juce::jmax(difference.maxError, std::abs(error));
+                errorEnergy += (double) error * error;
+                referenceEnergy += (double) r[i] * r[i];
+            }
+        }
+
+        if (errorEnergy > 0.0)
+            difference.nullDepthDb = 10.0 * std::log10(errorEnergy / juce::jmax(referenceEnergy, 1.0e-30));
+
+        return difference;
+    }
+
+    bool runCase(const CaseInfo& info)
+    {
+        const bool update = juce::SystemStats::getEnvironmentVariable("THE_CHANNEL_STRIP_UPDATE_GOLDEN", {}).getIntValue() != 0;
+        bool passed = true;
+
+        for (const auto& preset : presets())
+        {
+            std::vector<int> segmentStarts;
+            const auto output = renderAll(info.id, preset, segmentStarts);
+            const auto file = getReferenceFile(info, preset);
+
+            if (update)
+            {
+                const bool written = writeReference(file, output);
+                Test::log(juce::String(written ? "recorded " : "FAILED to record ") + file.getFileName());
+                passed = passed && written;
+                continue;
+            }
+
+            juce::AudioBuffer<float> reference;
+            if (!file.existsAsFile())
+            {
+                Test::log("FAIL " + juce::String(preset.name) + ": no reference " + file.getFileName()
+                          + " (record with THE_CHANNEL_STRIP_UPDATE_GOLDEN=1)");
+                passed = false;
+                continue;
+            }
+
+            if (!readReference(file, reference)
+                || reference.getNumChannels() != output.getNumChannels()
+                || reference.getNumSamples() != output.getNumSamples())
+            {
+                Test::log("FAIL " + juce::String(preset.name) + ": unreadable reference or signal layout changed, "
+                          + file.getFileName());
+                passed = false;
+                continue;
+            }
+
+            for (size_t s = 0; s < TestSignals::all().size(); ++s)
+            {
+                const int start = segmentStarts[s];
+                const int end = s + 1 < segmentStarts.size() ? segmentStarts[s + 1] : output.getNumSamples();
+                const auto difference = compare(output, reference, start, end - start);
+                const bool ok = difference.maxError <= info.tolerance;
+
+                Test::log(juce::String(ok ? "ok   " : "FAIL ")
+                          + juce::String(preset.name).paddedRight(' ', 10)
+                          + juce::String(TestSignals::all()[s].name).paddedRight(' ', 22)
+                          + "max error " + juce::String(juce::Decibels::gainToDecibels(difference.maxError, -200.0f), 1) + " dBFS, "
+                          + "null " + juce::String(difference.nullDepthDb, 1) + " dB");
+
+                passed = passed && ok;
+            }
+        }
+
+        return passed;
+    }
+
+    // ==============================================================================
+    // Inline biquad against juce::dsp::IIR::Filter
+    // ==============================================================================
+    // Every EQ band and HPF section design of every preset, over every signal,
+    // in the slices renderStage uses: the two must agree bit for bit
+    bool biquadMatchesFilter()
+    {
+        std::vector<std::array<float, 6>> designs;
+
+        for (const auto& preset : presets())
+        {
+            const auto p = makeParameters(preset);
+            designs.push_back(Equalizer::designLowBand(kSampleRate, p[P::eqLowGain], p[P::eqLowFreq], p.isOn(P::eqLowShelf)));
+            designs.push_back(Equalizer::designPeakBand(kSampleRate, p[P::eqLowMidGain], p[P::eqLowMidFreq], p[P::eqLowMidQ]));
+            designs.push_back(Equalizer::designPeakBand(kSampleRate, p[P::eqHighMidGain], p[P::eqHighMidFreq], p[P::eqHighMidQ]));
+            designs.push_back(Equalizer::designHighBand(kSampleRate, p[P::eqHighGain], p[P::eqHighFreq], p.isOn(P::eqHighShelf)));
+            designs.push_back(HighPassFilter::designSection(kSampleRate, p[P::hpfFreq]));
+        }
+
+        juce::int64 mismatches = 0;
+
+        for (const auto& c : designs)
+        {
+            for (const auto& signal : TestSignals::all())
+            {
+                auto expected = signal.make(kSampleRate);
+                auto actual = signal.make(kSampleRate);
+
+                juce::dsp::IIR::Coefficients<float>::Ptr coefficients = new juce::dsp::IIR::Coefficients<float>(
+                    c[0], c[1], c[2], c[3], c[4], c[5]);
+
+                std::array<juce::dsp::IIR::Filter<float>, 2> filters;
+                for (auto& filter : filters)
+                {
+                    filter.coefficients = coefficients;
+                    filter.reset();
+                }
+                Biquad biquad;
+                biquad.setCoefficients(c);
+
+                juce::dsp::AudioBlock<float> expectedBlock(expected), actualBlock(actual);
+                for (int start = 0; start < expected.getNumSamples(); start += kBlockSize)
+                {
+                    const auto length = (size_t) juce::jmin(kBlockSize, expected.getNumSamples() - start);
+
+                    for (size_t ch = 0; ch < filters.size(); ++ch)
+                    {
+                        auto channel = expectedBlock.getSingleChannelBlock(ch).getSubBlock((size_t) start, length);
+                        juce::dsp::ProcessContextReplacing<float> context(channel);
+                        filters[ch].process(context);
+                    }
+
+                    biquad.process(actualBlock.getSubBlock((size_t) start, length));
+                }
+
+                for (int ch = 0; ch < expected.getNumChannels(); ++ch)
+                    for (int i = 0; i < expected.getNumSamples(); ++i)
+                        if (!juce::exactlyEqual(actual.getSample(ch, i), expected.getSample(ch, i)))
+                            ++mismatches;
+            }
+        }
+
+        Test::log(juce::String((int) designs.size()) + " designs x " + juce::String((int) TestSignals::all().size())
+                  + " signals, " + juce::String(mismatches) + " samples differ from IIR::Filter");
+        return mismatches == 0;
+    }
+
+    Test::Registration biquadTest("Golden output: inline biquad matches IIR::Filter", biquadMatchesFilter);
+    Test::Registration inputTest("Golden output: input stage", [] { return runCase(kCases[0]); });
+    Test::Registration hpfTest("Golden output: high-pass filter", [] { return runCase(kCases[1]); });
+    Test::Registration eqTest("Golden output: equalizer", [] { return runCase(kCases[2]); });
+    Test::Registration gateTest("Golden output: gate", [] { return runCase(kCases[3]); });
+    Test::Registration compTest("Golden output: compressor", [] { return runCase(kCases[4]); });
+    Test::Registration limiterTest("Golden output: limiter", [] { return runCase(kCases[5]); });
+    Test::Registration outputTest("Golden output: output stage", [] { return runCase(kCases[6]); });
+    Test::Registration chainTest("Golden output: full chain", [] { return runCase(kCases[7]); });
+}
@@ -0,0 +1,28 @@
+#include "Test.h"
+#include <juce_events/juce_events.h>
+
+int main(int argc, char* argv[])
+{
+    // Processors expect a message manager
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    const juce::String filter = argc > 1 ? juce::String(argv[1]) : juce::String();
+    int run = 0, failed = 0;
+
+    for (const auto& test : Test::registry())
+    {
+        if (filter.isNotEmpty() && !test.name.containsIgnoreCase(filter))
+            continue;
+
+        std::printf("%s\n", test.name.toRawUTF8());
+        const bool passed = test.run();
+        std::printf("%s\n\n", passed ? "PASS" : "FAIL");
+
+        ++run;
+        if (!passed)
+            ++failed;
+    }
+
+    std::printf("%d of %d tests passed\n", run - failed, run);
+    return run > 0 && failed == 0 ? 0 : 1;
+}
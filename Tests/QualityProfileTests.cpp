@@ -0,0 +1,113 @@
+#include "Test.h"
+#include "PluginProcessor.h"
+#include "ParameterIDs.h"
+
+/**
+ * Quality profile tests
+ *
+ * A bounce only lines up if the reported latency is the latency of the path
+ * that actually ran. With default parameters the strip is transparent, so
+ * the output should null against the input shifted by getLatencySamples() -
+ * in both profiles, processed and bypassed.
+ */
+namespace
+{
+    constexpr double kSampleRate = 48000.0;
+    constexpr int kBlockSize = 256;
+    constexpr int kLength = 16 * kBlockSize;
+
+    // Tones well inside the oversampling filters' passband
+    juce::AudioBuffer<float> makeInput()
+    {
+        juce::AudioBuffer<float> buffer(2, kLength);
+
+        for (int i = 0; i < kLength; ++i)
+        {
+            const double t = i / kSampleRate;
+            const double twoPi = juce::MathConstants<double>::twoPi;
+            buffer.setSample(0, i, (float) (0.4 * std::sin(twoPi * 220.0 * t) + 0.2 * std::sin(twoPi * 1700.0 * t)));
+            buffer.setSample(1, i, (float) (0.4 * std::sin(twoPi * 330.0 * t) + 0.2 * std::sin(twoPi * 2900.0 * t)));
+        }
+
+        return buffer;
+    }
+
+    // Renders the input and returns the reported latency
+    int render(bool offline, bool bypassed, juce::AudioBuffer<float>& buffer)
+    {
+        TheChannelStripProcessor processor;
+
+        if (bypassed)
+            processor.getAPVTS().getParameter(ParamIDs::masterBypass)->setValueNotifyingHost(1.0f);
+
+        processor.setNonRealtime(offline);
+        processor.setRateAndBufferSizeDetails(kSampleRate, kBlockSize);
+        processor.prepareToPlay(kSampleRate, kBlockSize);
+
+        juce::MidiBuffer midi;
+        for (int start = 0; start < buffer.getNumSamples(); start += kBlockSize)
+        {
+            juce::AudioBuffer<float> slice(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, kBlockSize);
+            processor.processBlock(slice, midi);
+        }
+
+        const int latency = processor.getLatencySamples();
+        processor.releaseResources();
+        return latency;
+    }
+
+    // Residual of output against input shifted by `delay`, in dB relative to
+    // the input, over the second half (past the filters' start-up)
+    double nullDepthDb(const juce::AudioBuffer<float>& input, const juce::AudioBuffer<float>& output, int delay)
+    {
+        double error = 0.0, reference = 0.0;
+
+        for (int ch = 0; ch < input.getNumChannels(); ++ch)
+        {
+            for (int i = kLength / 2; i < kLength; ++i)
+            {
+                const double x = input.getSample(ch, i - delay);
+                const double e = output.getSample(ch, i) - x;
+                error += e * e;
+                reference += x * x;
+            }
+        }
+
+        return 10.0 * std::log10(juce::jmax(error, 1.0e-30) / reference);
+    }
+
+    bool checkProfile(bool offline, bool bypassed)
+    {
+        const auto input = makeInput();
+        auto output = input;
+        const int latency = render(offline, bypassed, output);
+
+        const double atLatency = nullDepthDb(input, output, latency);
+        const double early = nullDepthDb(input, output, latency + 1);
+        const double late = latency > 0 ? nullDepthDb(input, output, latency - 1) : 0.0;
+
+        Test::log(juce::String(offline ? "offline" : "realtime") + (bypassed ? ", bypassed" : "")
+                  + ": latency " + juce::String(latency) + " samples, null "
+                  + juce::String(atLatency, 1) + " dB (+/-1: " + juce::String(early, 1)
+                  + " / " + juce::String(late, 1) + " dB)");
+
+        // Offline oversamples, so it must report more than realtime's zero
+        if (offline != (latency > 0))
+            return false;
+
+        return atLatency < -40.0 && atLatency < early - 20.0 && atLatency < late - 20.0;
+    }
+
+    bool reportedLatencyMatches()
+    {
+        bool passed = true;
+
+        for (const bool offline : { false, true })
+            for (const bool bypassed : { false, true })
+                passed = checkProfile(offline, bypassed) && passed;
+
+        return passed;
+    }
+
+    Test::Registration latencyTest("Quality profiles: reported latency lines up", reportedLatencyMatches);
+}
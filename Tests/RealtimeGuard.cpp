@@ -0,0 +1,328 @@
+#include "RealtimeGuard.h"
+
+#if defined(__linux__) && defined(__GLIBC__)
+
+#include <atomic>
+#include <cerrno>
+#include <cstdarg>
+#include <cstdlib>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <time.h>
+#include <unistd.h>
+
+// glibc's own allocator entry points - forwarding to these instead of dlsym
+// keeps the malloc hooks usable before (and while) dlsym runs
+extern "C"
+{
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* ptr, size_t size);
+    void* __libc_memalign(size_t alignment, size_t size);
+    void __libc_free(void* ptr);
+}
+
+namespace
+{
+    using RealtimeGuard::Violation;
+
+    // Initial-exec TLS: reading it never calls into the dynamic loader
+    __attribute__((tls_model("initial-exec"))) thread_local int realtimeDepth = 0;
+
+    std::array<std::atomic<std::uint64_t>, RealtimeGuard::kNumViolations> violationCounts {};
+    std::atomic<const char*> firstFunction { nullptr };
+
+    const bool abortOnViolation = std::getenv("THE_CHANNEL_STRIP_RT_ABORT") != nullptr;
+
+    void trap(Violation violation, const char* function)
+    {
+        if (realtimeDepth == 0)
+            return;
+
+        violationCounts[(size_t) violation].fetch_add(1, std::memory_order_relaxed);
+
+        const char* expected = nullptr;
+        firstFunction.compare_exchange_strong(expected, function);
+
+        if (abortOnViolation)
+            std::abort();
+    }
+
+    // ==============================================================================
+    // Next definitions of the hooked functions, resolved before the guard is armed
+    // ==============================================================================
+    enum class Real
+    {
+        mutexLock = 0,
+        mutexTryLock,
+        rwlockRead,
+        rwlockWrite,
+        condWait,
+        condTimedWait,
+        condSignal,
+        condBroadcast,
+        semWait,
+        semPost,
+        nanoSleep,
+        clockNanoSleep,
+        microSleep,
+        schedYield,
+        read,
+        write,
+        syscall,
+        count
+    };
+
+    constexpr const char* realNames[] = {
+        "pthread_mutex_lock", "pthread_mutex_trylock", "pthread_rwlock_rdlock", "pthread_rwlock_wrlock",
+        "pthread_cond_wait", "pthread_cond_timedwait", "pthread_cond_signal", "pthread_cond_broadcast",
+        "sem_wait", "sem_post", "nanosleep", "clock_nanosleep", "usleep", "sched_yield",
+        "read", "write", "syscall"
+    };
+
+    static_assert(sizeof(realNames) / sizeof(realNames[0]) == static_cast<size_t>(Real::count),
+                  "every hooked function needs its libc name");
+
+    std::array<std::atomic<void*>, static_cast<size_t>(Real::count)> realAddresses {};
+
+    template <typename Fn>
+    Fn real(Real which)
+    {
+        auto& slot = realAddresses[(size_t) which];
+        void* address = slot.load(std::memory_order_acquire);
+
+        if (address == nullptr)
+        {
+            address = dlsym(RTLD_NEXT, realNames[(size_t) which]);
+            slot.store(address, std::memory_order_release);
+        }
+
+        return reinterpret_cast<Fn>(address);
+    }
+
+    void resolveAll()
+    {
+        for (int i = 0; i < static_cast<int>(Real::count); ++i)
+            real<void*>(static_cast<Real>(i));
+    }
+}
+
+// ==============================================================================
+// Hooks
+// ==============================================================================
+extern "C"
+{
+    void* malloc(size_t size) noexcept
+    {
+        trap(Violation::allocation, "malloc");
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size) noexcept
+    {
+        trap(Violation::allocation, "calloc");
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* ptr, size_t size) noexcept
+    {
+        trap(Violation::allocation, "realloc");
+        return __libc_realloc(ptr, size);
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size) noexcept
+    {
+        trap(Violation::allocation, "aligned_alloc");
+        return __libc_memalign(alignment, size);
+    }
+
+    int posix_memalign(void** result, size_t alignment, size_t size) noexcept
+    {
+        trap(Violation::allocation, "posix_memalign");
+
+        if (alignment < sizeof(void*) || (alignment & (alignment - 1)) != 0)
+            return EINVAL;
+
+        *result = __libc_memalign(alignment, size);
+        return *result != nullptr || size == 0 ? 0 : ENOMEM;
+    }
+
+    void free(void* ptr) noexcept
+    {
+        if (ptr != nullptr)
+            trap(Violation::deallocation, "free");
+
+        __libc_free(ptr);
+    }
+
+    int pthread_mutex_lock(pthread_mutex_t* mutex) noexcept
+    {
+        trap(Violation::lock, "pthread_mutex_lock");
+        return real<int (*)(pthread_mutex_t*)>(Real::mutexLock)(mutex);
+    }
+
+    int pthread_mutex_trylock(pthread_mutex_t* mutex) noexcept
+    {
+        trap(Violation::lock, "pthread_mutex_trylock");
+        return real<int (*)(pthread_mutex_t*)>(Real::mutexTryLock)(mutex);
+    }
+
+    int pthread_rwlock_rdlock(pthread_rwlock_t* lock) noexcept
+    {
+        trap(Violation::lock, "pthread_rwlock_rdlock");
+        return real<int (*)(pthread_rwlock_t*)>(Real::rwlockRead)(lock);
+    }
+
+    int pthread_rwlock_wrlock(pthread_rwlock_t* lock) noexcept
+    {
+        trap(Violation::lock, "pthread_rwlock_wrlock");
+        return real<int (*)(pthread_rwlock_t*)>(Real::rwlockWrite)(lock);
+    }
+
+    int pthread_cond_wait(pthread_cond_t* condition, pthread_mutex_t* mutex)
+    {
+        trap(Violation::lock, "pthread_cond_wait");
+        return real<int (*)(pthread_cond_t*, pthread_mutex_t*)>(Real::condWait)(condition, mutex);
+    }
+
+    int pthread_cond_timedwait(pthread_cond_t* condition, pthread_mutex_t* mutex, const struct timespec* time)
+    {
+        trap(Violation::lock, "pthread_cond_timedwait");
+        return real<int (*)(pthread_cond_t*, pthread_mutex_t*, const struct timespec*)>(Real::condTimedWait)(condition, mutex, time);
+    }
+
+    int pthread_cond_signal(pthread_cond_t* condition) noexcept
+    {
+        trap(Violation::lock, "pthread_cond_signal");
+        return real<int (*)(pthread_cond_t*)>(Real::condSignal)(condition);
+    }
+
+    int pthread_cond_broadcast(pthread_cond_t* condition) noexcept
+    {
+        trap(Violation::lock, "pthread_cond_broadcast");
+        return real<int (*)(pthread_cond_t*)>(Real::condBroadcast)(condition);
+    }
+
+    int sem_wait(sem_t* semaphore)
+    {
+        trap(Violation::lock, "sem_wait");
+        return real<int (*)(sem_t*)>(Real::semWait)(semaphore);
+    }
+
+    int sem_post(sem_t* semaphore) noexcept
+    {
+        trap(Violation::lock, "sem_post");
+        return real<int (*)(sem_t*)>(Real::semPost)(semaphore);
+    }
+
+    int nanosleep(const struct timespec* request, struct timespec* remaining)
+    {
+        trap(Violation::systemCall, "nanosleep");
+        return real<int (*)(const struct timespec*, struct timespec*)>(Real::nanoSleep)(request, remaining);
+    }
+
+    int clock_nanosleep(clockid_t clock, int flags, const struct timespec* request, struct timespec* remaining)
+    {
+        trap(Violation::systemCall, "clock_nanosleep");
+        return real<int (*)(clockid_t, int, const struct timespec*, struct timespec*)>(Real::clockNanoSleep)(clock, flags, request, remaining);
+    }
+
+    int usleep(useconds_t microseconds)
+    {
+        trap(Violation::systemCall, "usleep");
+        return real<int (*)(useconds_t)>(Real::microSleep)(microseconds);
+    }
+
+    int sched_yield() noexcept
+    {
+        trap(Violation::systemCall, "sched_yield");
+        return real<int (*)()>(Real::schedYield)();
+    }
+
+    ssize_t read(int fd, void* data, size_t size)
+    {
+        trap(Violation::systemCall, "read");
+        return real<ssize_t (*)(int, void*, size_t)>(Real::read)(fd, data, size);
+    }
+
+    ssize_t write(int fd, const void* data, size_t size)
+    {
+        trap(Violation::systemCall, "write");
+        return real<ssize_t (*)(int, const void*, size_t)>(Real::write)(fd, data, size);
+    }
+
+    // Catches raw futex waits (std::atomic::wait, libstdc++ internals). Six
+    // arguments are always forwarded, as the kernel ABI ignores unused ones.
+    long syscall(long number, ...) noexcept
+    {
+        va_list args;
+        va_start(args, number);
+        long a[6];
+        for (auto& arg : a)
+            arg = va_arg(args, long);
+        va_end(args);
+
+        trap(Violation::systemCall, "syscall");
+        return real<long (*)(long, ...)>(Real::syscall)(number, a[0], a[1], a[2], a[3], a[4], a[5]);
+    }
+}
+
+// ==============================================================================
+// Public API
+// ==============================================================================
+namespace RealtimeGuard
+{
+    bool isAvailable() { return true; }
+
+    Report takeReport()
+    {
+        Report report;
+
+        for (int i = 0; i < kNumViolations; ++i)
+            report.counts[(size_t) i] = violationCounts[(size_t) i].exchange(0, std::memory_order_relaxed);
+
+        report.firstFunction = firstFunction.exchange(nullptr);
+        return report;
+    }
+
+    ScopedRealtime::ScopedRealtime()
+    {
+        if (realtimeDepth == 0)
+            resolveAll();
+
+        ++realtimeDepth;
+    }
+
+    ScopedRealtime::~ScopedRealtime()
+    {
+        --realtimeDepth;
+    }
+}
+
+#else
+
+namespace RealtimeGuard
+{
+    bool isAvailable() { return false; }
+    Report takeReport() { return {}; }
+    ScopedRealtime::ScopedRealtime() {}
+    ScopedRealtime::~ScopedRealtime() {}
+}
+
+#endif
+
+const char* RealtimeGuard::getName(Violation violation)
+{
+    switch (violation)
+    {
+        case Violation::allocation:   return "allocation";
+        case Violation::deallocation: return "deallocation";
+        case Violation::lock:         return "lock";
+        case Violation::systemCall:   return "system call";
+        case Violation::count:        break;
+    }
+
+    return "unknown";
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+/**
+ * Real-time guard - The Channel Strip tests
+ *
+ * Interposes the libc entry points that must never be reached from the audio
+ * thread: the malloc family, pthread mutex/rwlock/condition/semaphore calls
+ * and blocking or I/O system calls (sleep, yield, read, write, syscall).
+ * Calls made while a ScopedRealtime is alive on the calling thread are
+ * counted and then forwarded, so a failing test still finishes its run.
+ *
+ * Only available on Linux/glibc (isAvailable() is false elsewhere). Set
+ * THE_CHANNEL_STRIP_RT_ABORT=1 to abort on the first violation instead, which
+ * leaves the offending call on the stack for a debugger or core dump.
+ */
+namespace RealtimeGuard
+{
+    enum class Violation
+    {
+        allocation = 0,
+        deallocation,
+        lock,
+        systemCall,
+        count
+    };
+
+    static constexpr int kNumViolations = static_cast<int>(Violation::count);
+
+    struct Report
+    {
+        std::array<std::uint64_t, kNumViolations> counts {};
+        const char* firstFunction = nullptr;    // first trapped libc function name
+
+        std::uint64_t total() const
+        {
+            std::uint64_t sum = 0;
+            for (auto count : counts)
+                sum += count;
+            return sum;
+        }
+    };
+
+    bool isAvailable();
+
+    // Returns everything trapped since the last call and clears it
+    Report takeReport();
+
+    const char* getName(Violation violation);
+
+    // Marks the current thread as the audio thread for its lifetime
+    class ScopedRealtime
+    {
+    public:
+        ScopedRealtime();
+        ~ScopedRealtime();
+
+        ScopedRealtime(const ScopedRealtime&) = delete;
+        ScopedRealtime& operator=(const ScopedRealtime&) = delete;
+    };
+}
@@ -0,0 +1,304 @@
+#include "Test.h"
+#include "RealtimeGuard.h"
+#include "PluginProcessor.h"
+#include "ParameterIDs.h"
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr double kSampleRate = 48000.0;
+    constexpr int kPreparedBlockSize = 512;
+    constexpr int kMaxBlockSize = 8192;     // Hosts may exceed what they prepared with
+    constexpr int kBlocksPerScenario = 3000;
+
+    using Action = std::function<void(TheChannelStripProcessor&, juce::Random&)>;
+
+    void setParameter(TheChannelStripProcessor& processor, const char* id, float normalised)
+    {
+        if (auto* param = processor.getAPVTS().getParameter(id))
+            param->setValueNotifyingHost(normalised);
+    }
+
+    void enableAllStages(TheChannelStripProcessor& processor)
+    {
+        for (auto* id : { ParamIDs::hpfEnabled, ParamIDs::eqEnabled, ParamIDs::gateEnabled,
+                          ParamIDs::compEnabled, ParamIDs::limiterEnabled, ParamIDs::autoGain })
+            setParameter(processor, id, 1.0f);
+    }
+
+    void randomiseParameters(TheChannelStripProcessor& processor, juce::Random& random)
+    {
+        for (int i = 0; i < ParamIDs::numParameters; ++i)
+        {
+            const auto index = static_cast<ParamIDs::Index>(i);
+            if (index == ParamIDs::Index::masterBypass || index == ParamIDs::Index::snapshotCompare)
+                continue;
+
+            setParameter(processor, ParamIDs::all[i], random.nextFloat());
+        }
+    }
+
+    juce::String describe(const RealtimeGuard::Report& report)
+    {
+        juce::String text;
+
+        for (int i = 0; i < RealtimeGuard::kNumViolations; ++i)
+        {
+            const auto count = report.counts[(size_t) i];
+            if (count > 0)
+                text << RealtimeGuard::getName(static_cast<RealtimeGuard::Violation>(i)) << " x" << (juce::int64) count << ", ";
+        }
+
+        if (report.firstFunction != nullptr)
+            text << "first: " << report.firstFunction;
+
+        return text;
+    }
+
+    // Block sizes vary from 1 to the prepared size, as some hosts do, and
+    // every so often go far past it
+    int nextBlockSize(juce::Random& random)
+    {
+        static constexpr int oversized[] = { kPreparedBlockSize + 1, 4096, kMaxBlockSize };
+
+        if (random.nextInt(16) == 0)
+            return oversized[random.nextInt((int) std::size(oversized))];
+
+        return 1 + random.nextInt(kPreparedBlockSize);
+    }
+
+    // Plays noise through processBlock on a separate audio thread with the
+    // guard armed around each call, while this (message) thread keeps running
+    // `mutate` until the audio thread finishes.
+    bool runScenario(const Action& setup, const Action& mutate)
+    {
+        if (!RealtimeGuard::isAvailable())
+        {
+            Test::log("skipped: libc hooks are only available on Linux/glibc");
+            return true;
+        }
+
+        juce::Random random(0x5eed);
+
+        TheChannelStripProcessor processor;
+        setup(processor, random);
+        processor.setRateAndBufferSizeDetails(kSampleRate, kPreparedBlockSize);
+        processor.prepareToPlay(kSampleRate, kPreparedBlockSize);
+
+        juce::AudioBuffer<float> noise(2, kMaxBlockSize);
+        for (int ch = 0; ch < noise.getNumChannels(); ++ch)
+            for (int i = 0; i < kMaxBlockSize; ++i)
+                noise.setSample(ch, i, (random.nextFloat() * 2.0f - 1.0f) * 0.5f);
+
+        juce::AudioBuffer<float> buffer(2, kMaxBlockSize);
+        juce::MidiBuffer midi;
+        std::atomic<bool> finished { false };
+
+        // Anything trapped during setup belongs to no one
+        RealtimeGuard::takeReport();
+
+        std::thread audioThread([&] {
+            juce::Random blockSizes(42);
+
+            for (int block = 0; block < kBlocksPerScenario; ++block)
+            {
+                const int numSamples = nextBlockSize(blockSizes);
+                buffer.setSize(2, numSamples, false, false, true);
+
+                for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                    buffer.copyFrom(ch, 0, noise, ch, 0, numSamples);
+
+                RealtimeGuard::ScopedRealtime realtime;
+                processor.processBlock(buffer, midi);
+            }
+
+            finished.store(true);
+        });
+
+        int changes = 0;
+        while (!finished.load())
+        {
+            mutate(processor, random);
+            ++changes;
+            juce::Thread::sleep(1);
+        }
+
+        audioThread.join();
+        const auto report = RealtimeGuard::takeReport();
+        processor.releaseResources();
+
+        Test::log(juce::String(kBlocksPerScenario) + " blocks, " + juce::String(changes) + " message-thread changes");
+
+        if (report.total() > 0)
+        {
+            Test::log("audio thread violations: " + describe(report));
+            return false;
+        }
+
+        return true;
+    }
+
+    // ==============================================================================
+    // Cases
+    // ==============================================================================
+    std::atomic<void*> allocationSink { nullptr };
+
+    bool guardSelfTest()
+    {
+        if (!RealtimeGuard::isAvailable())
+        {
+            Test::log("skipped: libc hooks are only available on Linux/glibc");
+            return true;
+        }
+
+        juce::CriticalSection lock;
+        RealtimeGuard::takeReport();
+
+        {
+            RealtimeGuard::ScopedRealtime realtime;
+            allocationSink.store(std::malloc(64));
+            std::free(allocationSink.exchange(nullptr));
+            const juce::ScopedLock scopedLock(lock);
+        }
+
+        // Outside the scope nothing may be counted
+        allocationSink.store(std::malloc(64));
+        std::free(allocationSink.exchange(nullptr));
+
+        const auto report = RealtimeGuard::takeReport();
+        Test::log("trapped " + describe(report));
+
+        using V = RealtimeGuard::Violation;
+        return report.counts[(size_t) V::allocation] == 1
+            && report.counts[(size_t) V::deallocation] == 1
+            && report.counts[(size_t) V::lock] >= 1;
+    }
+
+    bool steadyPlayback()
+    {
+        return runScenario(
+            [](auto& processor, auto& random) { randomiseParameters(processor, random); enableAllStages(processor); },
+            [](auto&, auto&) {});
+    }
+
+    bool parameterChanges()
+    {
+        // Every block sees new values, so every stage recomputes its coefficients
+        return runScenario(
+            [](auto& processor, auto&) { enableAllStages(processor); },
+            [](auto& processor, auto& random) { randomiseParameters(processor, random); });
+    }
+
+    bool bypassToggles()
+    {
+        return runScenario(
+            [](auto& processor, auto&) { enableAllStages(processor); },
+            [](auto& processor, auto& random) {
+                static constexpr const char* toggles[] = {
+                    ParamIDs::masterBypass, ParamIDs::hpfEnabled, ParamIDs::eqEnabled, ParamIDs::gateEnabled,
+                    ParamIDs::compEnabled, ParamIDs::limiterEnabled, ParamIDs::autoGain, ParamIDs::inputPad
+                };
+
+                setParameter(processor, toggles[random.nextInt((int) std::size(toggles))], random.nextBool() ? 1.0f : 0.0f);
+            });
+    }
+
+    bool channelModesAndLinks()
+    {
+        // The paths the plain parameter sweep rarely lands on together:
+        // mid/side sections, routing, unlinked detectors, lookahead and drive
+        return runScenario(
+            [](auto& processor, auto&) { enableAllStages(processor); },
+            [](auto& processor, auto& random) {
+                static constexpr const char* switches[] = {
+                    ParamIDs::eqMode, ParamIDs::gateMode, ParamIDs::compMode, ParamIDs::limiterMode,
+                    ParamIDs::stageOrder, ParamIDs::gateLink, ParamIDs::compLink, ParamIDs::limiterLink,
+                    ParamIDs::gateLookahead, ParamIDs::compLookahead, ParamIDs::gateHold,
+                    ParamIDs::inputSaturation, ParamIDs::inputDrive, ParamIDs::outputWidth
+                };
+
+                setParameter(processor, switches[random.nextInt((int) std::size(switches))], random.nextFloat());
+            });
+    }
+
+    bool offlineProfile()
+    {
+        // Prepared offline: oversampled drive, double detectors and the
+        // precision EQ. Flipping the flag mid-stream switches the profile on
+        // the audio thread, which must not allocate; parameter changes keep
+        // every path busy.
+        return runScenario(
+            [](auto& processor, auto& random) {
+                randomiseParameters(processor, random);
+                enableAllStages(processor);
+                processor.setNonRealtime(true);
+            },
+            [](auto& processor, auto& random) {
+                processor.setNonRealtime(random.nextBool());
+                setParameter(processor, ParamIDs::all[random.nextInt(ParamIDs::numParameters)], random.nextFloat());
+            });
+    }
+
+    bool stateRestore()
+    {
+        auto states = std::make_shared<std::vector<juce::MemoryBlock>>();
+
+        return runScenario(
+            [states](auto& processor, auto& random) {
+                // Binary states from differently configured instances...
+                for (int i = 0; i < 4; ++i)
+                {
+                    TheChannelStripProcessor source;
+                    randomiseParameters(source, random);
+                    enableAllStages(source);
+                    source.storeSnapshot(1);
+
+                    states->emplace_back();
+                    source.getStateInformation(states->back());
+                }
+
+                // ...plus a 1.0 XML state, which goes through the migration path
+                auto tree = processor.getAPVTS().copyState();
+                std::unique_ptr<juce::XmlElement> xml(tree.createXml());
+                states->emplace_back();
+                juce::AudioProcessor::copyXmlToBinary(*xml, states->back());
+            },
+            [states](auto& processor, auto& random) {
+                const auto& state = (*states)[(size_t) random.nextInt((int) states->size())];
+                processor.setStateInformation(state.getData(), (int) state.getSize());
+            });
+    }
+
+    bool snapshotCompare()
+    {
+        return runScenario(
+            [](auto& processor, auto& random) {
+                enableAllStages(processor);
+                randomiseParameters(processor, random);
+                processor.storeSnapshot(0);
+                randomiseParameters(processor, random);
+                processor.storeSnapshot(1);
+                setParameter(processor, ParamIDs::snapshotCompare, 1.0f);
+            },
+            [](auto& processor, auto& random) {
+                // Morphing, plus republishing the bank while the audio thread reads it
+                setParameter(processor, ParamIDs::snapshotMorph, random.nextFloat());
+
+                if (random.nextInt(8) == 0)
+                    processor.storeSnapshot(random.nextInt(2));
+            });
+    }
+
+    Test::Registration guardTest("Real-time safety: guard self-test", guardSelfTest);
+    Test::Registration steadyTest("Real-time safety: steady playback", steadyPlayback);
+    Test::Registration parameterTest("Real-time safety: parameter changes", parameterChanges);
+    Test::Registration bypassTest("Real-time safety: bypass toggles", bypassToggles);
+    Test::Registration modesTest("Real-time safety: channel modes, links and lookahead", channelModesAndLinks);
+    Test::Registration profileTest("Real-time safety: offline profile", offlineProfile);
+    Test::Registration stateTest("Real-time safety: setStateInformation during playback", stateRestore);
+    Test::Registration snapshotTest("Real-time safety: snapshot compare", snapshotCompare);
+}
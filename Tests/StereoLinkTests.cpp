@@ -0,0 +1,224 @@
+#include "Test.h"
+#include "DSP/Gate.h"
+#include "DSP/Compressor.h"
+#include "DSP/Limiter.h"
+
+/**
+ * Stereo link tests
+ *
+ * A quiet left channel next to a loud burst on the right. Linked, the right
+ * channel drives the dynamics on both; unlinked, the left channel's output
+ * must not depend on the right at all, and the per-channel gain reduction
+ * must tell the channels apart.
+ *
+ * Unlinked, the compressor converts to and from dB with Lanes'
+ * approximations; they have to stay within StereoLink::kDecibelTolerance of
+ * juce::Decibels, and an unlinked compressor fed the same signal on both
+ * channels has to match the exact linked one within that bound.
+ */
+namespace
+{
+    constexpr double kSampleRate = 48000.0;
+    constexpr int kBlockSize = 64;
+    constexpr int kLength = 64 * kBlockSize;
+
+    juce::AudioBuffer<float> makeInput(bool loudRight)
+    {
+        juce::AudioBuffer<float> buffer(2, kLength);
+
+        for (int i = 0; i < kLength; ++i)
+        {
+            const double phase = juce::MathConstants<double>::twoPi * 440.0 * i / kSampleRate;
+            buffer.setSample(0, i, (float) (0.02 * std::sin(phase)));
+            buffer.setSample(1, i, loudRight ? (float) (0.9 * std::sin(phase * 1.5)) : 0.0f);
+        }
+
+        return buffer;
+    }
+
+    struct Result
+    {
+        juce::AudioBuffer<float> output;
+        float leftGainReduction = 0.0f;     // Deepest over the blocks (dB)
+        float rightGainReduction = 0.0f;
+    };
+
+    template <typename Stage, typename Configure>
+    Result render(float linkPercent, bool loudRight, Configure&& configure)
+    {
+        Result result { makeInput(loudRight) };
+
+        Stage stage;
+        stage.prepare({ kSampleRate, (juce::uint32) kBlockSize, 2 });
+        configure(stage);
+        stage.setStereoLink(linkPercent);
+
+        juce::dsp::AudioBlock<float> whole(result.output);
+        for (int start = 0; start < kLength; start += kBlockSize)
+        {
+            auto block = whole.getSubBlock((size_t) start, (size_t) kBlockSize);
+            juce::dsp::ProcessContextReplacing<float> context(block);
+            stage.process(context);
+
+            result.leftGainReduction = juce::jmin(result.leftGainReduction, stage.getGainReduction(0));
+            result.rightGainReduction = juce::jmin(result.rightGainReduction, stage.getGainReduction(1));
+        }
+
+        return result;
+    }
+
+    bool sameChannel(const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b, int channel)
+    {
+        return std::equal(a.getReadPointer(channel), a.getReadPointer(channel) + kLength, b.getReadPointer(channel));
+    }
+
+    template <typename Stage, typename Configure>
+    bool checkStage(const char* name, Configure&& configure)
+    {
+        const auto unlinked = render<Stage>(0.0f, true, configure);
+        const auto alone = render<Stage>(0.0f, false, configure);
+        const auto linked = render<Stage>(100.0f, true, configure);
+
+        const bool independent = sameChannel(unlinked.output, alone.output, 0);
+        const bool keyed = !sameChannel(linked.output, alone.output, 0);
+        const bool metered = std::abs(unlinked.leftGainReduction - unlinked.rightGainReduction) > 1.0f
+                             && juce::exactlyEqual(linked.leftGainReduction, linked.rightGainReduction);
+
+        Test::log(juce::String(name) + ": unlinked GR L " + juce::String(unlinked.leftGainReduction, 2)
+                  + " / R " + juce::String(unlinked.rightGainReduction, 2) + " dB, linked GR "
+                  + juce::String(linked.leftGainReduction, 2) + " dB"
+                  + (independent ? "" : ", left depends on right when unlinked")
+                  + (keyed ? "" : ", right does not key left when linked"));
+
+        return independent && keyed && metered;
+    }
+
+    bool unlinkedChannelsAreIndependent()
+    {
+        bool passed = true;
+
+        // The gate closes on the quiet left channel unless the right holds it open
+        passed = checkStage<Gate>("gate", [](Gate& gate) {
+            gate.setThreshold(-20.0f);
+            gate.setRange(-40.0f);
+        }) && passed;
+
+        passed = checkStage<Compressor>("compressor", [](Compressor& comp) {
+            comp.setThreshold(-20.0f);
+            comp.setRatio(8.0f);
+            comp.setKnee(0.0f);
+        }) && passed;
+
+        passed = checkStage<Limiter>("limiter", [](Limiter& limiter) {
+            limiter.setCeiling(-6.0f);
+        }) && passed;
+
+        return passed;
+    }
+
+    // Worst difference (dB) of the Lanes conversions from juce::Decibels over
+    // their ranges, in both detector precisions
+    template <typename T>
+    float worstConversionError()
+    {
+        using Lanes = StereoLink::Lanes<T>;
+        constexpr int kSteps = 100000;
+        double worst = 0.0;
+
+        for (int i = 0; i <= kSteps; ++i)
+        {
+            const auto gain = (T) std::pow(2.0, -14.0 + 24.0 * i / kSteps);
+            const auto dB = (T) (Lanes::kMinDecibels * i / kSteps);
+
+            const double toDecibels = Lanes::expand(gain).gainToDecibels().get(0);
+            const double toGain = Lanes::expand(dB).decibelsToGain().get(1);
+
+            worst = juce::jmax(worst,
+                               std::abs(toDecibels - 20.0 * std::log10((double) gain)),
+                               std::abs(20.0 * std::log10(toGain) - (double) dB));
+        }
+
+        return (float) worst;
+    }
+
+    // Same signal on both channels, swelling from -60 dBFS to 0 dBFS so the
+    // detector crosses below, inside and above the knee
+    juce::AudioBuffer<float> makeSwell()
+    {
+        juce::AudioBuffer<float> buffer(2, kLength);
+
+        for (int i = 0; i < kLength; ++i)
+        {
+            const double phase = juce::MathConstants<double>::twoPi * 220.0 * i / kSampleRate;
+            const double level = std::pow(10.0, -3.0 + 3.0 * i / kLength);
+            buffer.setSample(0, i, (float) (level * std::sin(phase)));
+            buffer.setSample(1, i, buffer.getSample(0, i));
+        }
+
+        return buffer;
+    }
+
+    juce::AudioBuffer<float> renderSwell(float linkPercent, bool doublePrecision)
+    {
+        auto buffer = makeSwell();
+
+        Compressor comp;
+        comp.prepare({ kSampleRate, (juce::uint32) kBlockSize, 2 });
+        comp.setThreshold(-30.0f);
+        comp.setRatio(8.0f);
+        comp.setKnee(12.0f);
+        comp.setAttack(1.0f);
+        comp.setDoublePrecisionDetector(doublePrecision);
+        comp.setStereoLink(linkPercent);
+
+        juce::dsp::AudioBlock<float> whole(buffer);
+        for (int start = 0; start < kLength; start += kBlockSize)
+        {
+            auto block = whole.getSubBlock((size_t) start, (size_t) kBlockSize);
+            juce::dsp::ProcessContextReplacing<float> context(block);
+            comp.process(context);
+        }
+
+        return buffer;
+    }
+
+    bool approximationsStayWithinBound()
+    {
+        bool passed = true;
+
+        for (const auto [name, error] : { std::pair { "float", worstConversionError<float>() },
+                                          std::pair { "double", worstConversionError<double>() } })
+        {
+            Test::log(juce::String(name) + " dB conversions: worst error " + juce::String(error, 7) + " dB");
+            passed = error <= StereoLink::kDecibelTolerance && passed;
+        }
+
+        // Output gain error of twice the bound (in and out of dB), plus a
+        // float ulp of headroom for the signal itself
+        const double bound = std::pow(10.0, 2.0 * StereoLink::kDecibelTolerance / 20.0) - 1.0 + 1.0e-6;
+
+        for (const bool doublePrecision : { false, true })
+        {
+            const auto linked = renderSwell(100.0f, doublePrecision);
+            const auto unlinked = renderSwell(0.0f, doublePrecision);
+            double worst = 0.0;
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < kLength; ++i)
+                {
+                    const double reference = linked.getSample(ch, i);
+                    const double difference = std::abs(unlinked.getSample(ch, i) - reference);
+                    worst = juce::jmax(worst, difference - bound * std::abs(reference));
+                }
+
+            Test::log(juce::String(doublePrecision ? "double" : "float")
+                      + " detector: unlinked vs linked excess over the bound " + juce::String(worst, 9));
+            passed = worst <= 0.0 && passed;
+        }
+
+        return passed;
+    }
+
+    Test::Registration independenceTest("Stereo link: unlinked channels are independent", unlinkedChannelsAreIndependent);
+    Test::Registration approximationTest("Stereo link: unlinked dB approximations stay within bound", approximationsStayWithinBound);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+/**
+ * Minimal test harness - The Channel Strip
+ * Every .cpp in Tests/ registers its cases with a static Registration;
+ * Main.cpp runs every case whose name contains the command-line filter and
+ * exits non-zero if any of them fails. CTest runs one filter per suite.
+ */
+namespace Test
+{
+    struct Case
+    {
+        juce::String name;
+        std::function<bool()> run;      // true on pass
+    };
+
+    inline std::vector<Case>& registry()
+    {
+        static std::vector<Case> cases;
+        return cases;
+    }
+
+    struct Registration
+    {
+        Registration(const char* name, std::function<bool()> run)
+        {
+            registry().push_back({ name, std::move(run) });
+        }
+    };
+
+    inline void log(const juce::String& message)
+    {
+        std::printf("  %s\n", message.toRawUTF8());
+    }
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
+#include <iterator>
+
+/**
+ * Deterministic stereo test signals - The Channel Strip tests
+ * Everything is generated from fixed seeds and closed-form expressions, so
+ * the same build renders bit-identical input on every run.
+ */
+namespace TestSignals
+{
+    struct Signal
+    {
+        const char* name;
+        juce::AudioBuffer<float> (*make)(double sampleRate);
+    };
+
+    // Exponential sine sweep 20 Hz - 20 kHz at -6 dBFS; right channel 90 degrees ahead
+    inline juce::AudioBuffer<float> sweep(double sampleRate)
+    {
+        const int length = juce::roundToInt(sampleRate * 0.35);
+        const double f1 = 20.0, f2 = 20000.0, duration = length / sampleRate;
+        const double rate = std::log(f2 / f1);
+
+        juce::AudioBuffer<float> buffer(2, length);
+        for (int i = 0; i < length; ++i)
+        {
+            const double t = i / sampleRate;
+            const double phase = juce::MathConstants<double>::twoPi * f1 * duration / rate
+                               * (std::exp(t * rate / duration) - 1.0);
+
+            buffer.setSample(0, i, (float) (0.5 * std::sin(phase)));
+            buffer.setSample(1, i, (float) (0.5 * std::cos(phase)));
+        }
+
+        return buffer;
+    }
+
+    // Offset impulses per channel, then a full-scale negative spike on both
+    inline juce::AudioBuffer<float> impulses(double sampleRate)
+    {
+        const int length = juce::roundToInt(sampleRate * 0.15);
+
+        juce::AudioBuffer<float> buffer(2, length);
+        buffer.clear();
+        buffer.setSample(0, 0, 0.5f);
+        buffer.setSample(1, 64, 0.5f);
+        buffer.setSample(0, length / 2, -1.0f);
+        buffer.setSample(1, length / 2, -1.0f);
+
+        return buffer;
+    }
+
+    // 40 ms white-noise bursts every 75 ms at rising levels (-48, -30, -12, 0 dBFS peak)
+    inline juce::AudioBuffer<float> noiseBursts(double sampleRate)
+    {
+        const int length = juce::roundToInt(sampleRate * 0.3);
+        const int period = juce::roundToInt(sampleRate * 0.075);
+        const int burst = juce::roundToInt(sampleRate * 0.04);
+        const float levels[] = { -48.0f, -30.0f, -12.0f, 0.0f };
+
+        juce::Random random(0x6e6f697365);
+        juce::AudioBuffer<float> buffer(2, length);
+        buffer.clear();
+
+        for (int i = 0; i < length; ++i)
+        {
+            const int index = juce::jmin(i / period, (int) std::size(levels) - 1);
+            if (i % period >= burst)
+                continue;
+
+            const float gain = juce::Decibels::decibelsToGain(levels[index]);
+            for (int ch = 0; ch < 2; ++ch)
+                buffer.setSample(ch, i, (random.nextFloat() * 2.0f - 1.0f) * gain);
+        }
+
+        return buffer;
+    }
+
+    // 100 ms of digital silence, then a 2 kHz tone at -1 dBFS with a 15 ms decay
+    inline juce::AudioBuffer<float> silenceToTransient(double sampleRate)
+    {
+        const int length = juce::roundToInt(sampleRate * 0.2);
+        const int onset = juce::roundToInt(sampleRate * 0.1);
+        const float peak = juce::Decibels::decibelsToGain(-1.0f);
+
+        juce::AudioBuffer<float> buffer(2, length);
+        buffer.clear();
+
+        for (int i = onset; i < length; ++i)
+        {
+            const double t = (i - onset) / sampleRate;
+            const float value = peak * (float) (std::exp(-t / 0.015) * std::sin(juce::MathConstants<double>::twoPi * 2000.0 * t + 0.5));
+            buffer.setSample(0, i, value);
+            buffer.setSample(1, i, value);
+        }
+
+        return buffer;
+    }
+
+    inline const std::array<Signal, 4>& all()
+    {
+        static const std::array<Signal, 4> signals { {
+            { "sweep", sweep },
+            { "impulses", impulses },
+            { "noise bursts", noiseBursts },
+            { "silence to transient", silenceToTransient }
+        } };
+
+        return signals;
+    }
+}
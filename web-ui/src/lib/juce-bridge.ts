@@ -378,3 +378,12 @@ export function addCustomEventListener(
     window.__JUCE__!.backend.removeEventListener(token);
   };
 }
+
+export function emitCustomEvent(eventId: string, payload: unknown = {}): void {
+  if (!isInJuceWebView()) {
+    console.log('[JUCE Bridge] Not in WebView, custom event ignored:', eventId);
+    return;
+  }
+
+  window.__JUCE__!.backend.emitEvent(eventId, payload);
+}
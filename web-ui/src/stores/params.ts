@@ -9,6 +9,7 @@ import {
   getToggleState,
   getComboBoxState,
   addCustomEventListener,
+  emitCustomEvent,
   isInJuceWebView,
   type SliderState,
   type ToggleState,
@@ -146,24 +147,84 @@ export function createComboStore(paramId: string, defaultIndex = 0): ComboStore
 // Visualizer Data Store
 // ==============================================================================
 
+// Only sent by builds with THE_CHANNEL_STRIP_STAGE_TIMING enabled
+export interface StageTiming {
+  name: string;
+  mean: number;
+  p99: number;
+  max: number;
+  budget: number;
+}
+
+// Meter levels are linear; peak fall-back, hold and RMS integration are
+// applied in C++, overs count samples at or above 0 dBFS since the last reset
 export interface VisualizerData {
   inputLevelL: number;
   inputLevelR: number;
+  inputHoldL: number;
+  inputHoldR: number;
+  inputRmsL: number;
+  inputRmsR: number;
+  inputOvers: number;
   outputLevelL: number;
   outputLevelR: number;
+  outputHoldL: number;
+  outputHoldR: number;
+  outputRmsL: number;
+  outputRmsR: number;
+  outputOvers: number;
   gateGR: number;
   compGR: number;
   limiterGR: number;
+  gateGRL: number;
+  gateGRR: number;
+  compGRL: number;
+  compGRR: number;
+  limiterGRL: number;
+  limiterGRR: number;
+  gateLevel: number;
+  compLevel: number;
+  autoGainDb: number;
+  lufsMomentary: number;
+  lufsShortTerm: number;
+  lufsIntegrated: number;
+  loudnessRange: number;
+  truePeak: number;
+  stageTimings?: StageTiming[];
 }
 
 const defaultVisualizerData: VisualizerData = {
   inputLevelL: 0,
   inputLevelR: 0,
+  inputHoldL: 0,
+  inputHoldR: 0,
+  inputRmsL: 0,
+  inputRmsR: 0,
+  inputOvers: 0,
   outputLevelL: 0,
   outputLevelR: 0,
+  outputHoldL: 0,
+  outputHoldR: 0,
+  outputRmsL: 0,
+  outputRmsR: 0,
+  outputOvers: 0,
   gateGR: 0,
   compGR: 0,
   limiterGR: 0,
+  gateGRL: 0,
+  gateGRR: 0,
+  compGRL: 0,
+  compGRR: 0,
+  limiterGRL: 0,
+  limiterGRR: 0,
+  gateLevel: -100,
+  compLevel: -100,
+  autoGainDb: 0,
+  lufsMomentary: -100,
+  lufsShortTerm: -100,
+  lufsIntegrated: -100,
+  loudnessRange: 0,
+  truePeak: -100,
 };
 
 export const visualizerData = writable<VisualizerData>(defaultVisualizerData);
@@ -174,3 +235,42 @@ if (typeof window !== 'undefined') {
     visualizerData.set(data as VisualizerData);
   });
 }
+
+// ==============================================================================
+// Transfer Curves (computed in C++, resent when their parameters change)
+// ==============================================================================
+export interface TransferCurveData {
+  minDb: number;
+  maxDb: number;
+  comp: number[];
+  gate: number[];
+  gateClose: number[];
+}
+
+export const transferCurves = writable<TransferCurveData | null>(null);
+
+if (typeof window !== 'undefined') {
+  addCustomEventListener('transferCurves', (data) => {
+    transferCurves.set(data as TransferCurveData);
+  });
+  emitCustomEvent('requestTransferCurves');
+}
+
+// ==============================================================================
+// EQ Frequency Response (HPF + EQ, computed in C++ per band, resent on change)
+// ==============================================================================
+export interface FrequencyResponseData {
+  minHz: number;
+  maxHz: number;
+  magnitudeDb: number[];
+  phaseDegrees: number[];
+}
+
+export const frequencyResponse = writable<FrequencyResponseData | null>(null);
+
+if (typeof window !== 'undefined') {
+  addCustomEventListener('frequencyResponse', (data) => {
+    frequencyResponse.set(data as FrequencyResponseData);
+  });
+  emitCustomEvent('requestFrequencyResponse');
+}